@@ -1,17 +1,614 @@
 #pragma once
-#include <tchar.h>
 #include <vector>
 #include <string>
-#include <locale.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <utility>
+#include <type_traits>
+#include <limits>
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L
+#define INTELLIGENT_CAST_HAS_STRING_VIEW
+#include <string_view>
+// std::to_chars and std::from_chars replace the self-contained routines for char when INTELLIGENT_CAST_USE_CHARCONV is defined
+#if defined(INTELLIGENT_CAST_USE_CHARCONV) && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#if defined(__cpp_lib_to_chars)
+#define INTELLIGENT_CAST_HAS_CHARCONV
+#endif
+#endif
+#endif
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// routines shared with IntelligentCastConstexpr.h are constexpr where C++14 relaxed constexpr is available
+#if (defined(__cpp_constexpr) && __cpp_constexpr >= 201304L) || (defined(_MSC_VER) && _MSC_VER >= 1910)
+#define INTELLIGENT_CAST_HAS_CONSTEXPR14
+#define INTELLIGENT_CAST_CONSTEXPR14 constexpr
+#else
+#define INTELLIGENT_CAST_CONSTEXPR14 inline
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INTELLIGENT_CAST_HAS_SSE2
+#include <emmintrin.h>
+#endif
+// range of the table of small integer texts, see intelligent_cast_small_integer
+#if !defined(INTELLIGENT_CAST_SMALL_INTEGER_MIN)
+#define INTELLIGENT_CAST_SMALL_INTEGER_MIN 0
+#endif
+#if !defined(INTELLIGENT_CAST_SMALL_INTEGER_MAX)
+#define INTELLIGENT_CAST_SMALL_INTEGER_MAX 9999
+#endif
+#include "IntelligentCastPow10Table.h"
+#if defined(INTELLIGENT_CAST_ENABLE_STATISTICS)
+#include "IntelligentCastStatistics.h"
+#endif
 
 namespace intelligent_cast_detail
 {
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief decode one UTF-8 sequence
+	 * @return false if [p, last) does not start with a valid sequence
+	 * @param[in,out]	p : first byte of the sequence, advanced past the sequence if it is valid
+	 * @param[in]	last : one past the last byte
+	 * @param[out]	code_point : decoded code point
+	 *
+	 *	overlong forms, surrogates and code points above U+10FFFF are rejected.
+	 */
+	//---------------------------------------------------------------------------
+	inline bool decode_utf8(const char*& p, const char* last, unsigned int& code_point)
+	{
+		const unsigned int lead = static_cast<unsigned char>(p[0]);
+		if(lead < 0x80u)
+		{
+			code_point = lead;
+			p += 1;
+			return true;
+		}
+		if(lead < 0xC2u || lead > 0xF4u || last - p < 2 || (static_cast<unsigned char>(p[1]) & 0xC0u) != 0x80u)
+		{
+			return false;
+		}
+		const unsigned int c1 = static_cast<unsigned char>(p[1]) & 0x3Fu;
+		if(lead < 0xE0u)
+		{
+			code_point = ((lead & 0x1Fu) << 6) | c1;
+			p += 2;
+			return true;
+		}
+		if(last - p < 3 || (static_cast<unsigned char>(p[2]) & 0xC0u) != 0x80u)
+		{
+			return false;
+		}
+		const unsigned int c2 = static_cast<unsigned char>(p[2]) & 0x3Fu;
+		if(lead < 0xF0u)
+		{
+			code_point = ((lead & 0x0Fu) << 12) | (c1 << 6) | c2;
+			if(code_point < 0x800u || (code_point >= 0xD800u && code_point <= 0xDFFFu))
+			{
+				return false;
+			}
+			p += 3;
+			return true;
+		}
+		if(last - p < 4 || (static_cast<unsigned char>(p[3]) & 0xC0u) != 0x80u)
+		{
+			return false;
+		}
+		code_point = ((lead & 0x07u) << 18) | (c1 << 12) | (c2 << 6) | (static_cast<unsigned char>(p[3]) & 0x3Fu);
+		if(code_point < 0x10000u || code_point > 0x10FFFFu)
+		{
+			return false;
+		}
+		p += 4;
+		return true;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief decode one UTF-8 sequence which is already validated by decode_utf8
+	 */
+	//---------------------------------------------------------------------------
+	inline unsigned int decode_valid_utf8(const char*& p)
+	{
+		const unsigned int lead = static_cast<unsigned char>(p[0]);
+		if(lead < 0xE0u)
+		{
+			const unsigned int code_point = ((lead & 0x1Fu) << 6) | (static_cast<unsigned char>(p[1]) & 0x3Fu);
+			p += 2;
+			return code_point;
+		}
+		if(lead < 0xF0u)
+		{
+			const unsigned int code_point = ((lead & 0x0Fu) << 12) | ((static_cast<unsigned char>(p[1]) & 0x3Fu) << 6) |
+				(static_cast<unsigned char>(p[2]) & 0x3Fu);
+			p += 3;
+			return code_point;
+		}
+		const unsigned int code_point = ((lead & 0x07u) << 18) | ((static_cast<unsigned char>(p[1]) & 0x3Fu) << 12) |
+			((static_cast<unsigned char>(p[2]) & 0x3Fu) << 6) | (static_cast<unsigned char>(p[3]) & 0x3Fu);
+		p += 4;
+		return code_point;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief encode one code point to UTF-8
+	 */
+	//---------------------------------------------------------------------------
+	inline size_t utf8_length(unsigned int code_point)
+	{
+		return code_point < 0x80u ? 1 : code_point < 0x800u ? 2 : code_point < 0x10000u ? 3 : 4;
+	}
+	inline char* encode_utf8(char* out, unsigned int code_point)
+	{
+		if(code_point < 0x80u)
+		{
+			*out++ = static_cast<char>(code_point);
+		}
+		else if(code_point < 0x800u)
+		{
+			*out++ = static_cast<char>(0xC0u | (code_point >> 6));
+			*out++ = static_cast<char>(0x80u | (code_point & 0x3Fu));
+		}
+		else if(code_point < 0x10000u)
+		{
+			*out++ = static_cast<char>(0xE0u | (code_point >> 12));
+			*out++ = static_cast<char>(0x80u | ((code_point >> 6) & 0x3Fu));
+			*out++ = static_cast<char>(0x80u | (code_point & 0x3Fu));
+		}
+		else
+		{
+			*out++ = static_cast<char>(0xF0u | (code_point >> 18));
+			*out++ = static_cast<char>(0x80u | ((code_point >> 12) & 0x3Fu));
+			*out++ = static_cast<char>(0x80u | ((code_point >> 6) & 0x3Fu));
+			*out++ = static_cast<char>(0x80u | (code_point & 0x3Fu));
+		}
+		return out;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief encoding of wide string
+	 *
+	 *	2 byte wchar_t (Windows) holds UTF-16, and 4 byte wchar_t holds UTF-32.
+	 */
+	//---------------------------------------------------------------------------
+	template<size_t WideSize = sizeof(wchar_t)>
+	struct wide_encoding
+	{
+		/** the maximum number of UTF-8 bytes per wide character */
+		static const size_t max_utf8_length = 4;
+
+		static size_t length(unsigned int /*code_point*/)
+		{
+			return 1;
+		}
+		static wchar_t* encode(wchar_t* out, unsigned int code_point)
+		{
+			*out++ = static_cast<wchar_t>(code_point);
+			return out;
+		}
+		static bool decode(const wchar_t*& p, const wchar_t* /*last*/, unsigned int& code_point)
+		{
+			code_point = static_cast<unsigned int>(*p);
+			if(code_point > 0x10FFFFu || (code_point >= 0xD800u && code_point <= 0xDFFFu))
+			{
+				return false;
+			}
+			++p;
+			return true;
+		}
+	};
+	template<>
+	struct wide_encoding<2>
+	{
+		/** a surrogate pair is 4 bytes in UTF-8, so 3 bytes per wide character is enough */
+		static const size_t max_utf8_length = 3;
+
+		static size_t length(unsigned int code_point)
+		{
+			return code_point < 0x10000u ? 1 : 2;
+		}
+		static wchar_t* encode(wchar_t* out, unsigned int code_point)
+		{
+			if(code_point < 0x10000u)
+			{
+				*out++ = static_cast<wchar_t>(code_point);
+			}
+			else
+			{
+				code_point -= 0x10000u;
+				*out++ = static_cast<wchar_t>(0xD800u | (code_point >> 10));
+				*out++ = static_cast<wchar_t>(0xDC00u | (code_point & 0x3FFu));
+			}
+			return out;
+		}
+		static bool decode(const wchar_t*& p, const wchar_t* last, unsigned int& code_point)
+		{
+			code_point = static_cast<unsigned short>(*p);
+			if(code_point >= 0xD800u && code_point <= 0xDFFFu)
+			{
+				if(code_point >= 0xDC00u || last - p < 2)
+				{
+					return false;
+				}
+				const unsigned int low = static_cast<unsigned short>(p[1]);
+				if(low < 0xDC00u || low > 0xDFFFu)
+				{
+					return false;
+				}
+				code_point = 0x10000u + ((code_point - 0xD800u) << 10) + (low - 0xDC00u);
+				p += 2;
+				return true;
+			}
+			++p;
+			return true;
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief count trailing zero bits of non zero value
+	 */
+	//---------------------------------------------------------------------------
+	inline int count_trailing_zeros(unsigned int val)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, val);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(val);
+#endif
+	}
+#if defined(INTELLIGENT_CAST_HAS_SSE2)
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief store 16 bytes as 16 wide characters
+	 */
+	//---------------------------------------------------------------------------
+	inline void widen_bytes(__m128i bytes, wchar_t* out)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+		const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+		if(sizeof(wchar_t) == 2)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), low);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), high);
+		}
+		else
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(low, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(low, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(high, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+		}
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief pack 16 wide characters to bytes
+	 * @return bit mask of the non ASCII characters, whose bytes in packed are meaningless
+	 * @param[in]	p : 16 characters, which are not negative if wchar_t is 4 bytes
+	 * @param[out]	packed : the characters in bytes
+	 */
+	//---------------------------------------------------------------------------
+	inline unsigned int narrow_characters(const wchar_t* p, __m128i& packed)
+	{
+		if(sizeof(wchar_t) == 2)
+		{
+			// 0x7F80 is added to take the sign bit as non ASCII, as packing saturates signed 16 bits
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8));
+			const __m128i offset = _mm_set1_epi16(0x7F80);
+			packed = _mm_packus_epi16(a, b);
+			return static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(_mm_adds_epu16(a, offset), _mm_adds_epu16(b, offset))));
+		}
+		// a character from U+0080 saturates to a byte from 0x80
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8));
+		const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+		packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+		return static_cast<unsigned int>(_mm_movemask_epi8(packed));
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief validate 16 bytes of UTF-8 with the same rules as decode_utf8
+	 * @return false if the block has an invalid sequence, or misses the continuation bytes of the previous block
+	 * @param[in]	bytes : the block
+	 * @param[in]	previous : the previous block, or zero for the first block
+	 *
+	 *	a sequence which continues after the block is validated with the next block.
+	 */
+	//---------------------------------------------------------------------------
+	inline bool validate_utf8(__m128i bytes, __m128i previous)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		// the bytes 1, 2 and 3 before each byte
+		const __m128i previous1 = _mm_or_si128(_mm_slli_si128(bytes, 1), _mm_srli_si128(previous, 15));
+		const __m128i previous2 = _mm_or_si128(_mm_slli_si128(bytes, 2), _mm_srli_si128(previous, 14));
+		const __m128i previous3 = _mm_or_si128(_mm_slli_si128(bytes, 3), _mm_srli_si128(previous, 13));
+		// a continuation byte is exactly where a lead byte of 2, 3 or 4 byte sequence needs it
+		const __m128i continuation = _mm_cmplt_epi8(bytes, _mm_set1_epi8(static_cast<char>(0xC0)));
+		const __m128i needed = _mm_or_si128(_mm_subs_epu8(previous1, _mm_set1_epi8(static_cast<char>(0xBF))),
+			_mm_or_si128(_mm_subs_epu8(previous2, _mm_set1_epi8(static_cast<char>(0xDF))), _mm_subs_epu8(previous3, _mm_set1_epi8(static_cast<char>(0xEF)))));
+		__m128i error = _mm_cmpeq_epi8(continuation, _mm_cmpeq_epi8(needed, zero));
+		// C0 and C1 are overlong, and F5 to FF are beyond U+10FFFF
+		error = _mm_or_si128(error, _mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8(static_cast<char>(0xFE))), _mm_set1_epi8(static_cast<char>(0xC0))));
+		error = _mm_or_si128(error, _mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(static_cast<char>(0xF5))), bytes));
+		// the second byte after E0, ED, F0 and F4 excludes overlong forms, surrogates and beyond U+10FFFF
+		error = _mm_or_si128(error, _mm_and_si128(_mm_cmpeq_epi8(previous1, _mm_set1_epi8(static_cast<char>(0xE0))),
+			_mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(static_cast<char>(0x9F))), bytes)));
+		error = _mm_or_si128(error, _mm_and_si128(_mm_cmpeq_epi8(previous1, _mm_set1_epi8(static_cast<char>(0xED))),
+			_mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(static_cast<char>(0xA0))), bytes)));
+		error = _mm_or_si128(error, _mm_and_si128(_mm_cmpeq_epi8(previous1, _mm_set1_epi8(static_cast<char>(0xF0))),
+			_mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(static_cast<char>(0x8F))), bytes)));
+		error = _mm_or_si128(error, _mm_and_si128(_mm_cmpeq_epi8(previous1, _mm_set1_epi8(static_cast<char>(0xF4))),
+			_mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(static_cast<char>(0x90))), bytes)));
+		return _mm_movemask_epi8(error) == 0;
+	}
+#endif
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief transcoder between UTF-8 string and wide string
+	 *
+	 *	length counts the characters converted from [first, last) and stops at the first invalid sequence.\n
+	 *	write converts the valid range found by length without validating again, and writes exactly that number of characters.\n
+	 *	with SSE2, length validates and counts 16 characters at a time, and write stores the ASCII prefix of a block mixing ASCII
+	 *	and non ASCII characters at once, by the trailing zeros of the mask of non ASCII characters, before decoding the rest.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename OutCharT, typename CharT>
+	struct transcoder;
+
+	template<>
+	struct transcoder<wchar_t, char>
+	{
+		/** the maximum number of wide characters per byte */
+		static const size_t max_length = 1;
+
+		static size_t length(const char* first, const char* last, const char*& valid_last)
+		{
+			size_t length = 0;
+#if defined(INTELLIGENT_CAST_HAS_SSE2)
+			// the characters of each valid block are counted as the bytes except continuation bytes, adding 4 byte sequences again
+			// for the surrogate pairs of UTF-16
+			const char* const begin = first;
+			const __m128i zero = _mm_setzero_si128();
+			__m128i previous = zero;
+			while(last - first >= 16)
+			{
+				const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+				// an ASCII block is valid unless a sequence in the last 3 bytes of the previous block continues into it
+				if((_mm_movemask_epi8(bytes) | (_mm_movemask_epi8(previous) & 0xE000)) != 0)
+				{
+					if(!validate_utf8(bytes, previous))
+					{
+						break;
+					}
+					__m128i characters = _mm_sub_epi8(zero, _mm_cmpgt_epi8(bytes, _mm_set1_epi8(static_cast<char>(0xBF))));
+					if(sizeof(wchar_t) == 2)
+					{
+						characters = _mm_sub_epi8(characters, _mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(static_cast<char>(0xF0))), bytes));
+					}
+					const __m128i sums = _mm_sad_epu8(characters, zero);
+					length += static_cast<size_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+				}
+				else
+				{
+					length += 16;
+				}
+				previous = bytes;
+				first += 16;
+			}
+			// the last sequence of the blocks can continue after them, so its lead byte is uncounted and it is decoded again below
+			for(int back = 1; back <= 3 && back <= first - begin; ++back)
+			{
+				const unsigned int byte = static_cast<unsigned char>(first[-back]);
+				if((byte & 0xC0u) != 0x80u)
+				{
+					if(byte >= 0xC0u && back < (byte >= 0xF0u ? 4 : byte >= 0xE0u ? 3 : 2))
+					{
+						first -= back;
+						length -= wide_encoding<>::length(byte >= 0xF0u ? 0x10000u : 0x80u);
+					}
+					break;
+				}
+			}
+#endif
+			unsigned int code_point;
+			while(first != last && decode_utf8(first, last, code_point))
+			{
+				length += wide_encoding<>::length(code_point);
+			}
+			valid_last = first;
+			return length;
+		}
+		static wchar_t* write(const char* first, const char* last, wchar_t* out)
+		{
+#if defined(INTELLIGENT_CAST_HAS_SSE2)
+			while(last - first >= 16)
+			{
+				const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+				const unsigned int non_ascii = static_cast<unsigned int>(_mm_movemask_epi8(bytes));
+				if(non_ascii == 0)
+				{
+					widen_bytes(bytes, out);
+					first += 16;
+					out += 16;
+					continue;
+				}
+				// the whole block is stored while 64 bytes, which are at least 16 characters, remain
+				const int ascii = count_trailing_zeros(non_ascii);
+				if(last - first >= 64)
+				{
+					widen_bytes(bytes, out);
+				}
+				else
+				{
+					for(int i = 0; i < ascii; ++i)
+					{
+						out[i] = static_cast<wchar_t>(first[i]);
+					}
+				}
+				first += ascii;
+				out += ascii;
+				while(first != last && static_cast<unsigned char>(*first) >= 0x80u)
+				{
+					out = wide_encoding<>::encode(out, decode_valid_utf8(first));
+				}
+			}
+#endif
+			while(first != last)
+			{
+				if(static_cast<unsigned char>(*first) < 0x80u)
+				{
+					*out++ = static_cast<wchar_t>(*first++);
+				}
+				else
+				{
+					out = wide_encoding<>::encode(out, decode_valid_utf8(first));
+				}
+			}
+			return out;
+		}
+	};
+	template<>
+	struct transcoder<char, wchar_t>
+	{
+		/** the maximum number of bytes per wide character */
+		static const size_t max_length = wide_encoding<>::max_utf8_length;
 
+		static size_t length(const wchar_t* first, const wchar_t* last, const wchar_t*& valid_last)
+		{
+			size_t length = 0;
+#if defined(INTELLIGENT_CAST_HAS_SSE2)
+			if(sizeof(wchar_t) == 4)
+			{
+				// UTF-32 is validated and counted without decoding, each character is 1 byte and 1 more byte from U+0080, U+0800 and U+10000
+				const __m128i zero = _mm_setzero_si128();
+				while(last - first >= 16)
+				{
+					__m128i units[4];
+					for(int i = 0; i < 4; ++i)
+					{
+						units[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i * 4));
+					}
+					const __m128i any = _mm_or_si128(_mm_or_si128(units[0], units[1]), _mm_or_si128(units[2], units[3]));
+					if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, _mm_set1_epi32(static_cast<int>(0xFFFFFF80u))), zero)) == 0xFFFF)
+					{
+						length += 16;
+						first += 16;
+						continue;
+					}
+					__m128i invalid = zero;
+					__m128i extra = zero;
+					for(int i = 0; i < 4; ++i)
+					{
+						invalid = _mm_or_si128(invalid, _mm_or_si128(
+							_mm_or_si128(_mm_cmplt_epi32(units[i], zero), _mm_cmpgt_epi32(units[i], _mm_set1_epi32(0x10FFFF))),
+							_mm_cmpeq_epi32(_mm_and_si128(units[i], _mm_set1_epi32(static_cast<int>(0xFFFFF800u))), _mm_set1_epi32(0xD800))));
+						extra = _mm_sub_epi32(extra, _mm_cmpgt_epi32(units[i], _mm_set1_epi32(0x7F)));
+						extra = _mm_sub_epi32(extra, _mm_cmpgt_epi32(units[i], _mm_set1_epi32(0x7FF)));
+						extra = _mm_sub_epi32(extra, _mm_cmpgt_epi32(units[i], _mm_set1_epi32(0xFFFF)));
+					}
+					if(_mm_movemask_epi8(invalid) != 0)
+					{
+						break;
+					}
+					extra = _mm_add_epi32(extra, _mm_shuffle_epi32(extra, _MM_SHUFFLE(1, 0, 3, 2)));
+					extra = _mm_add_epi32(extra, _mm_shuffle_epi32(extra, _MM_SHUFFLE(2, 3, 0, 1)));
+					length += 16 + static_cast<size_t>(_mm_cvtsi128_si32(extra));
+					first += 16;
+				}
+			}
+			else
+			{
+				// UTF-16 takes the ASCII prefix of each block, and decodes the rest for the surrogate pairs
+				__m128i packed;
+				while(last - first >= 16)
+				{
+					const unsigned int non_ascii = narrow_characters(first, packed);
+					const int ascii = non_ascii == 0 ? 16 : count_trailing_zeros(non_ascii);
+					length += static_cast<size_t>(ascii);
+					first += ascii;
+					unsigned int code_point;
+					while(first != last && static_cast<unsigned int>(*first) >= 0x80u && wide_encoding<>::decode(first, last, code_point))
+					{
+						length += utf8_length(code_point);
+					}
+					if(first != last && static_cast<unsigned int>(*first) >= 0x80u)
+					{
+						break;
+					}
+				}
+			}
+#endif
+			unsigned int code_point;
+			while(first != last && wide_encoding<>::decode(first, last, code_point))
+			{
+				length += utf8_length(code_point);
+			}
+			valid_last = first;
+			return length;
+		}
+		static char* write(const wchar_t* first, const wchar_t* last, char* out)
+		{
+#if defined(INTELLIGENT_CAST_HAS_SSE2)
+			// the whole block is stored for its ASCII prefix, as every wide character is at least 1 byte
+			__m128i packed;
+			while(last - first >= 16)
+			{
+				const unsigned int non_ascii = narrow_characters(first, packed);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+				const int ascii = non_ascii == 0 ? 16 : count_trailing_zeros(non_ascii);
+				first += ascii;
+				out += ascii;
+				unsigned int code_point;
+				while(first != last && static_cast<unsigned int>(*first) >= 0x80u && wide_encoding<>::decode(first, last, code_point))
+				{
+					out = encode_utf8(out, code_point);
+				}
+			}
+#endif
+			unsigned int code_point;
+			while(first != last && wide_encoding<>::decode(first, last, code_point))
+			{
+				out = encode_utf8(out, code_point);
+			}
+			return out;
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief convert character range to another type of string
+	 * @return StdStrType
+	 * @param[in]	first : first character
+	 * @param[in]	last : one past the last character
+	 *
+	 *	the length is counted first, then the characters are written in the result directly.
+	 *	if conversion failed, this provides the only characters before the invalid sequence.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType, typename CharT>
+	inline StdStrType transcode(const CharT* first, const CharT* last)
+	{
+		typedef transcoder<typename StdStrType::value_type, CharT> transcoder_type;
+		const CharT* valid_last;
+		StdStrType result(transcoder_type::length(first, last, valid_last), typename StdStrType::value_type());
+		if(!result.empty())
+		{
+			transcoder_type::write(first, valid_last, &result[0]);
+		}
+		return result;
+	}
 	//---------------------------------------------------------------------------
 	/**
 	 * @brief string->wstring conversion
 	 * @return std::wstring 
-	 * @param[in]	src : input string
+	 * @param[in]	src : input string in UTF-8
 	 *
 	 *	if conversion failed, this provides the only characters that can be converted.
 	 */
@@ -19,15 +616,12 @@ namespace intelligent_cast_detail
 	inline
 	std::wstring to_wstring_impl(const std::string& src)
 	{
-		std::vector<wchar_t> to(src.length() + 1);
-		size_t size;
-		mbstowcs_s(&size, &to[0], to.size(), src.c_str(), _TRUNCATE);
-		return std::wstring(&to[0], size-1);
+		return transcode<std::wstring>(src.data(), src.data() + src.size());
 	}
 	//---------------------------------------------------------------------------
 	/**
 	 * @brief wstring->string conversion
-	 * @return std::string
+	 * @return std::string in UTF-8
 	 * @param[in]	src : input string
 	 *
 	 *	if conversion failed, this provides the only characters that can be converted.
@@ -36,10 +630,7 @@ namespace intelligent_cast_detail
 	inline
 	std::string to_mbstring_impl(const std::wstring& src)
 	{
-		std::vector<char> to(src.length() * MB_CUR_MAX + 1);
-		size_t size;
-		wcstombs_s(&size, &to[0], to.size(), src.c_str(), _TRUNCATE);
-		return std::string(&to[0], size-1);
+		return transcode<std::string>(src.data(), src.data() + src.size());
 	}
 }	// End of Namespace intelligent_cast_detail
 
@@ -98,426 +689,2902 @@ namespace intelligent_cast_detail
 	}
 	//---------------------------------------------------------------------------
 	/**
-	 * @brief format string
-	 * @return std::string
-	 * @param[in]	src input
-	 * @param[in]	format : format
+	 * @brief table of decimal digit pairs from "00" to "99"
 	 *
-	 *	it format string that include numeric value
+	 *	digits are emitted two at a time from this table, so only one division is needed for two digits.
 	 */
 	//---------------------------------------------------------------------------
-	template<typename T>
-	std::string format(const T& src, const char* format)
+	template<typename Dummy = void>
+	struct digit_pair_table
 	{
-		char buf[255];
-		sprintf_s(buf, sizeof(buf)/sizeof(char), format, src); 
-		return std::string(buf);
-	}
-	template<typename T>
-	std::wstring format(const T& src, const wchar_t* format)
+		static const char pairs[201];
+	};
+	template<typename Dummy>
+	const char digit_pair_table<Dummy>::pairs[201] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief count decimal digits of unsigned value
+	 * @return number of digits (at least 1)
+	 * @param[in]	val : unsigned value
+	 */
+	//---------------------------------------------------------------------------
+	template<typename UInt>
+	inline int count_digits(UInt val)
 	{
-		wchar_t buf[255];
-		swprintf_s(buf, sizeof(buf)/sizeof(wchar_t), format, src); 
-		return std::wstring(buf);
+		int digits = 1;
+		for(;;)
+		{
+			if(val < 10u)		return digits;
+			if(val < 100u)		return digits + 1;
+			if(val < 1000u)		return digits + 2;
+			if(val < 10000u)	return digits + 3;
+			val /= 10000u;
+			digits += 4;
+		}
 	}
 	//---------------------------------------------------------------------------
 	/**
-	 * @brief conversion rule for convertiong string to another type of string
+	 * @brief write decimal digits of unsigned value backward
+	 * @param[in]	last : one past the last character to be written
+	 * @param[in]	val : unsigned value
 	 *
-	 *	this avoids unnecessary copying when From type and To type are same string type.
+	 *	exactly count_digits(val) characters are written in front of last.
 	 */
 	//---------------------------------------------------------------------------
-	template<typename From, typename To>
-	struct string_conversion_rules
-	{
-		typedef To result_type;
-		static result_type convert(const From& from){return interconvert_string(from);} 
-	};
-	template<typename From>
-	struct string_conversion_rules<From, From>
-	{
-		typedef const From& result_type;
-		static result_type convert(result_type from){return from;}
-	};
-
-//---------------------------------------------------------------------------
-/**
- * @brief   this macro defines converter class for converting numeric value to string, or converting string to numeric value
- * @param   type		 numeric value type
- * @param   namespace_ 	 namespace name for this type of conversion
- * @param   c_format 	 format string ro converting numeric value to string
- * @param   c_toval 	 conversion function for string to numeric value
- * @param   w_format 	 format string ro converting numeric value to wstring
- * @param   w_toval 	 conversion function for wstring to numeric value
- * @see     string_converter
- * 
- *   (example) converter for int
- * @code
-	NUMERIC_STRING_CONVERTER(
-						int, int_,	// any namespace is ok
-						"%d", "0123456789-", atoi(str.c_str()),		// for string
-						L"%d", L"0123456789-", _wtoi(str.c_str())	// for wstring
-						);
-
- * @endcode
- */
-//---------------------------------------------------------------------------
-#define NUMERIC_STRING_CONVERTER(type, namespace_, \
-								c_format, c_toval, w_format, w_toval) \
-	template<typename> struct namespace_##char_traits \
-	{ \
-	}; \
-	template<> struct namespace_##char_traits<char> \
-	{ \
-		static const char* format()							{ return c_format; } \
-		static type 		to_val(const std::string& str)	{ return c_toval; } \
-	}; \
-	template<> struct namespace_##char_traits<wchar_t> \
-	{ \
-		static const wchar_t* format()						{ return w_format;} \
-		static type		 to_val(const std::wstring& str)	{ return w_toval; } \
-	};\
-	template<typename StdStrType> \
-	struct string_converter<type, StdStrType> : string_convertible\
-	{ \
-	typedef StdStrType std_str_type;\
-	typedef type value_type; \
-	typedef typename StdStrType::value_type char_type;\
-	static std_str_type to_string(const value_type& val)	{ return format(val, namespace_##char_traits<char_type>::format()); }\
-	static value_type get_value(const StdStrType& str)	{ return namespace_##char_traits<char_type>::to_val(str.c_str()); } \
-	} \
-
-	struct string_unconvertible
-	{
-		static const bool is_convertible = false;
-	};
-
-	struct string_convertible
+	template<typename CharT, typename UInt>
+	inline void write_digits(CharT* last, UInt val)
 	{
-		static const bool is_convertible = true;
-	};
-
+		const char* pairs = digit_pair_table<>::pairs;
+		while(val >= 100u)
+		{
+			const unsigned int index = static_cast<unsigned int>(val % 100u) * 2;
+			val /= 100u;
+			*--last = static_cast<CharT>(pairs[index + 1]);
+			*--last = static_cast<CharT>(pairs[index]);
+		}
+		if(val >= 10u)
+		{
+			const unsigned int index = static_cast<unsigned int>(val) * 2;
+			*--last = static_cast<CharT>(pairs[index + 1]);
+			*--last = static_cast<CharT>(pairs[index]);
+		}
+		else
+		{
+			*--last = static_cast<CharT>('0' + val);
+		}
+	}
 	//---------------------------------------------------------------------------
 	/**
-	 * @brief converter class for string and numeric value
-	 * @param T string or numeric value or user defined class
-	 * @param StdStrType string class that must be std::string or std::wstring
+	 * @brief unsigned types used for generating digits of integral value
 	 *
-	 *	this class must be specialized. Specialized classes for numeric value are defined as macro above.
+	 *	types narrower than unsigned int are widened so that the arithmetic is done in native width.
 	 */
 	//---------------------------------------------------------------------------
-	template<typename T, typename StdStrType>
-	struct string_converter : string_unconvertible
+	template<typename T>
+	struct unsigned_digits_type
 	{
+		typedef typename std::make_unsigned<T>::type unsigned_type;
+		typedef typename std::conditional<
+			(sizeof(unsigned_type) < sizeof(unsigned int)), unsigned int, unsigned_type
+		>::type type;
 	};
 	//---------------------------------------------------------------------------
 	/**
-	 * @brief converter specialized for conversion between argment string type and std::string type.
-	 * @param String converted string type that must be std::string or std::wstring
+	 * @brief sign and magnitude of integral value
 	 *
-	 *	to_string function provides argment type to std::string.\n
-	 *  reduction function provides std::string to argment type.
+	 *	magnitude of negative value is computed in unsigned arithmetic not to overflow at the minimum value.
 	 */
 	//---------------------------------------------------------------------------
-	template<typename StdStrType>
-	struct string_converter<std::string, StdStrType> : string_convertible
+	template<typename T>
+	struct integral_magnitude
 	{
-		typedef std::string value_type, handle_type;
-		typedef typename string_conversion_rules<value_type, StdStrType>::result_type std_str_type;
-		typedef typename string_conversion_rules<StdStrType, value_type>::result_type reduction_type;
-		static std_str_type to_string(const value_type& val){ return string_conversion_rules<value_type, StdStrType>::convert(val); };
-		static reduction_type reduction(const StdStrType& string){ return string_converter<StdStrType, value_type>::to_string(string); }
-	
+		typedef typename unsigned_digits_type<T>::unsigned_type unsigned_type;
+		typedef typename unsigned_digits_type<T>::type digits_type;
+
+		explicit integral_magnitude(const T& src)
+			: negative(src < static_cast<T>(0))
+			, magnitude(negative ? static_cast<unsigned_type>(0u - static_cast<unsigned_type>(src)) : static_cast<unsigned_type>(src))
+			, length(count_digits(magnitude) + (negative ? 1 : 0))
+		{
+		}
+		/** write exactly length characters from out */
+		template<typename CharT>
+		void write(CharT* out) const
+		{
+			*out = static_cast<CharT>('-');
+			write_digits(out + length, magnitude);
+		}
+
+		bool negative;
+		digits_type magnitude;
+		int length;
 	};
 	//---------------------------------------------------------------------------
 	/**
-	 * @brief converter specialized for conversion between argment string type and std::wstring type.
-	 * @param String converted string type that must be std::string or std::wstring
+	 * @brief append integral value to string
+	 * @param[in,out]	dst : string appended to
+	 * @param[in]	src : input
 	 *
-	 *	to_string function provides argment type to std::wstring.\n
-	 *  reduction function provides std::wstring to argment type.
+	 *	the number of digits is counted up front, so the digits are written in place with at most one reallocation.
 	 */
 	//---------------------------------------------------------------------------
-	template<typename StdStrType>
-	struct string_converter<std::wstring, StdStrType> : string_convertible
+	template<typename StdStrType, typename T>
+	inline typename std::enable_if<std::is_integral<T>::value>::type
+	append_format(StdStrType& dst, const T& src)
 	{
-		typedef std::wstring value_type, handle_type;
-		typedef typename string_conversion_rules<value_type, StdStrType>::result_type std_str_type;
-		typedef typename string_conversion_rules<StdStrType, value_type>::result_type reduction_type;
-		static std_str_type to_string(const value_type& val){ return string_conversion_rules<value_type, StdStrType>::convert(val); };
-		static reduction_type reduction(const StdStrType& string){ return string_converter<StdStrType, value_type>::to_string(string); }
+		const integral_magnitude<T> digits(src);
+		const size_t size = dst.size();
+		dst.resize(size + digits.length);
+		digits.write(&dst[0] + size);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write integral value to buffer
+	 * @return one past the last character written, or NULL if the value does not fit in [first, last)
+	 * @param[in]	first : first character of buffer
+	 * @param[in]	last : one past the last character of buffer
+	 * @param[in]	src : input
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	inline typename std::enable_if<std::is_integral<T>::value, CharT*>::type
+	write_format(CharT* first, CharT* last, const T& src)
+	{
+		const integral_magnitude<T> digits(src);
+		if(last - first < digits.length)
+		{
+			return NULL;
+		}
+		digits.write(first);
+		return first + digits.length;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief unsigned 128-bit integer
+	 */
+	//---------------------------------------------------------------------------
+	struct uint128
+	{
+		unsigned long long high;
+		unsigned long long low;
 	};
 	//---------------------------------------------------------------------------
 	/**
-	 * @brief converter specialized for conversion between argment string type and const wchar_t*.
-	 * @param StdStrType a type which is converted to and which must be std::string or std::wstring
+	 * @brief full multiplication of 64-bit unsigned values
+	 * @return 128-bit product
+	 * @param[in]	a : multiplicand
+	 * @param[in]	b : multiplier
+	 */
+	//---------------------------------------------------------------------------
+	inline uint128 multiply_128(unsigned long long a, unsigned long long b)
+	{
+		uint128 result;
+#if defined(_MSC_VER) && defined(_M_X64)
+		result.low = _umul128(a, b, &result.high);
+#elif defined(__SIZEOF_INT128__)
+		__extension__ typedef unsigned __int128 uint128_type;
+		const uint128_type product = static_cast<uint128_type>(a) * b;
+		result.high = static_cast<unsigned long long>(product >> 64);
+		result.low = static_cast<unsigned long long>(product);
+#else
+		const unsigned long long a_low = a & 0xFFFFFFFFu, a_high = a >> 32;
+		const unsigned long long b_low = b & 0xFFFFFFFFu, b_high = b >> 32;
+		const unsigned long long low_low = a_low * b_low;
+		const unsigned long long high_low = a_high * b_low;
+		const unsigned long long cross = (low_low >> 32) + (high_low & 0xFFFFFFFFu) + a_low * b_high;
+		result.high = a_high * b_high + (high_low >> 32) + (cross >> 32);
+		result.low = (cross << 32) | (low_low & 0xFFFFFFFFu);
+#endif
+		return result;
+	}
+	/** floor(log10(2^e)) for e in [-1700, 1700] */
+	inline int floor_log10_pow2(int e)					{ return static_cast<int>((e * 661971961083LL) >> 41); }
+	/** floor(log10(3/4 * 2^e)) for e in [-1700, 1700] */
+	inline int floor_log10_three_quarters_pow2(int e)	{ return static_cast<int>((e * 661971961083LL - 274743187321LL) >> 41); }
+	/** floor(log2(10^e)) for e in [-1233, 1233] */
+	inline int floor_log2_pow10(int e)					{ return static_cast<int>((e * 913124641741LL) >> 38); }
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief rounded-to-odd upper bits of the product of power of ten and scaled significand
 	 *
-	 *	to_string function provides argment type to std::wstring.\n
-	 *  reduction function provides std::wstring to argment type.
+	 *	the lowest bit of the result is set when the discarded bits are not zero,
+	 *	which is sufficient to compare the product with the boundaries of the rounding interval.
 	 */
 	//---------------------------------------------------------------------------
-	template<typename StdStrType>
-	struct string_converter<const wchar_t*, StdStrType> : string_convertible
+	inline unsigned long long round_to_odd(const uint128& g, unsigned long long cp)
 	{
-		typedef StdStrType std_str_type;
-		typedef const wchar_t* value_type;
-		typedef value_type reduction_type;
-		typedef std::wstring handle_type;
-		static std_str_type to_string(value_type const val)	{ return string_converter<handle_type, StdStrType>::to_string(val); };
-		static reduction_type reduction(const StdStrType& string){ return string.c_str(); }
-	};
+		const uint128 x = multiply_128(g.low, cp);
+		const uint128 y = multiply_128(g.high, cp);
+		const unsigned long long y0 = y.low + x.high;
+		const unsigned long long y1 = y.high + (y0 < y.low ? 1 : 0);
+		return y1 | (y0 > 1 ? 1 : 0);
+	}
+	inline unsigned int round_to_odd(unsigned long long g, unsigned int cp)
+	{
+		const uint128 p = multiply_128(g, cp);
+		const unsigned int y1 = static_cast<unsigned int>(p.high);
+		const unsigned int y0 = static_cast<unsigned int>(p.low >> 32);
+		return y1 | (y0 > 1 ? 1u : 0u);
+	}
 	//---------------------------------------------------------------------------
 	/**
-	 * @brief converter specialized for conversion between argment string type and const char* type.
-	 * @param StdStrType a type which is converted to and which must be std::string or std::wstring
+	 * @brief binary layout of floating point type
 	 *
-	 *	to_string function provides argment type to std::string.\n
-	 *  reduction function provides std::string to argment type.
+	 *	pow10 provides the significand of 10^k rounded up,
+	 *	in the precision which is required by the shortest decimal conversion of the type.\n
+	 *	exact_pow10 provides 10^k which is exactly representable in the type, for k in [0, max_exact_exponent].\n
+	 *	the remaining constants bound the decimal exponents handled by parsing.
 	 */
 	//---------------------------------------------------------------------------
-	template<typename StdStrType>
-	struct string_converter<const char*, StdStrType> : string_convertible
+	template<typename T> struct floating_traits{};
+	template<> struct floating_traits<double>
 	{
-		typedef StdStrType std_str_type;
-		typedef const char* value_type;
-		typedef value_type reduction_type;
-		typedef std::string handle_type;
-		static std_str_type to_string(value_type const val)		{ return string_converter<handle_type, StdStrType>::to_string(val); };
-		static reduction_type reduction(const StdStrType& string){ return string.c_str(); }
+		typedef unsigned long long carrier_type;
+		typedef uint128 pow10_type;
+		static const int significand_bits = 52;
+		static const int exponent_bits = 11;
+		static const int exponent_bias = 1023;
+		static const int max_digits = 17;
+		static const int max_exact_exponent = 22;
+		static const unsigned long long max_exact_significand = 1ULL << 53;
+		static const int min_round_to_even_exponent = -4;
+		static const int max_round_to_even_exponent = 23;
+		static const int smallest_power_of_ten = -342;
+		static const int largest_power_of_ten = 308;
+		static const int max_parsed_digits = 768;
+		static double exact_pow10(int k)
+		{
+			static const double values[] =
+			{
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+			return values[k];
+		}
+		static pow10_type pow10(int k)
+		{
+			const unsigned long long* entry = pow10_significand_table<>::values[k - pow10_significand_table<>::min_exponent];
+			pow10_type g;
+			g.high = entry[0];
+			g.low = entry[1] + 1;
+			if(g.low == 0) ++g.high;
+			return g;
+		}
 	};
-#ifdef _AFX
-	template<typename StdStrType>
-	struct string_converter<CStringA, StdStrType> : string_convertible
+	template<> struct floating_traits<float>
 	{
-		typedef StdStrType std_str_type;
-		typedef CStringA value_type, reduction_type;
-		typedef std::string handle_type;	
-		static std_str_type to_string(value_type const& val)		{ return string_converter<handle_type, StdStrType>::to_string(val.GetString()); };
-		static reduction_type reduction(const StdStrType& string)	{ return reduction_type( string_converter<StdStrType, handle_type>::to_string(string).c_str() ); }
+		typedef unsigned int carrier_type;
+		typedef unsigned long long pow10_type;
+		static const int significand_bits = 23;
+		static const int exponent_bits = 8;
+		static const int exponent_bias = 127;
+		static const int max_digits = 9;
+		static const int max_exact_exponent = 10;
+		static const unsigned long long max_exact_significand = 1ULL << 24;
+		static const int min_round_to_even_exponent = -17;
+		static const int max_round_to_even_exponent = 10;
+		static const int smallest_power_of_ten = -65;
+		static const int largest_power_of_ten = 38;
+		static const int max_parsed_digits = 114;
+		static float exact_pow10(int k)
+		{
+			static const float values[] =
+			{
+				1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+			};
+			return values[k];
+		}
+		static pow10_type pow10(int k)
+		{
+			return pow10_significand_table<>::values[k - pow10_significand_table<>::min_exponent][0] + 1;
+		}
 	};
-	template<typename StdStrType>
-	struct string_converter<CStringW, StdStrType> : string_convertible
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief decimal representation of floating point value (significand * 10^exponent)
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	struct shortest_decimal
 	{
-		typedef StdStrType std_str_type;
-		typedef CStringW value_type, reduction_type;
-		typedef std::wstring handle_type;	
-		static std_str_type to_string(value_type const& val)		{ return string_converter<handle_type, StdStrType>::to_string(val.GetString()); };
-		static reduction_type reduction(const StdStrType& string)	{ return reduction_type( string_converter<StdStrType, handle_type>::to_string(string).c_str() ); }
+		typename floating_traits<T>::carrier_type significand;
+		int exponent;
 	};
-#endif
-
-NUMERIC_STRING_CONVERTER(int, int_,
-						"%d", atoi(str.c_str()),
-						L"%d", _wtoi(str.c_str()));
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief shortest decimal which is converted back to the same floating point value
+	 * @return decimal without trailing zeros
+	 * @param[in]	ieee_significand : stored significand bits
+	 * @param[in]	ieee_exponent : stored exponent bits, which must not be all ones
+	 *
+	 *	this is the Schubfach algorithm by Raffaello Giulietti.
+	 *	when several decimals of the shortest length are in the rounding interval, the closest one is chosen.\n
+	 *	value must not be zero.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	inline shortest_decimal<T> to_shortest_decimal(typename floating_traits<T>::carrier_type ieee_significand, int ieee_exponent)
+	{
+		typedef floating_traits<T> traits;
+		typedef typename traits::carrier_type carrier_type;
+		const int bias = traits::exponent_bias + traits::significand_bits;
 
-NUMERIC_STRING_CONVERTER(long, long_,
-						"%ld", atol(str.c_str()),
-					    L"%ld", _wtol(str.c_str()));
+		carrier_type c;
+		int q;
+		if(ieee_exponent != 0)
+		{
+			c = (static_cast<carrier_type>(1) << traits::significand_bits) | ieee_significand;
+			q = ieee_exponent - bias;
+		}
+		else
+		{
+			c = ieee_significand;
+			q = 1 - bias;
+		}
 
-NUMERIC_STRING_CONVERTER(unsigned int, uint_,
-						"%u", strtoul(str.c_str(), NULL, 10),
-					    L"%u", wcstoul(str.c_str(), NULL, 10));
+		const bool is_even = (c % 2) == 0;
+		const bool lower_boundary_is_closer = ieee_significand == 0 && ieee_exponent > 1;
 
-NUMERIC_STRING_CONVERTER(short, short_,
-						"%d", static_cast<short>( atoi(str.c_str()) ),
-					    L"%d", static_cast<short>( _wtoi(str.c_str()) ));
+		// boundaries of the rounding interval, scaled by 4
+		const carrier_type cbl = 4 * c - 2 + (lower_boundary_is_closer ? 1 : 0);
+		const carrier_type cb = 4 * c;
+		const carrier_type cbr = 4 * c + 2;
 
-NUMERIC_STRING_CONVERTER(unsigned short, ushort_,
-						"%u", static_cast<unsigned short>( strtoul(str.c_str(), NULL, 10) ),
-					    L"%u", static_cast<unsigned short>( wcstoul(str.c_str(), NULL, 10) ));
+		const int k = lower_boundary_is_closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+		const int h = q + floor_log2_pow10(-k) + 1;
 
-NUMERIC_STRING_CONVERTER(char, char_,
-						"%d", static_cast<char> ( atoi(str.c_str()) ),
-					    L"%d", static_cast<char> ( _wtoi(str.c_str())) );
+		const typename traits::pow10_type g = traits::pow10(-k);
+		const carrier_type vbl = round_to_odd(g, static_cast<carrier_type>(cbl << h));
+		const carrier_type vb = round_to_odd(g, static_cast<carrier_type>(cb << h));
+		const carrier_type vbr = round_to_odd(g, static_cast<carrier_type>(cbr << h));
 
-NUMERIC_STRING_CONVERTER(unsigned char, ucahr_,
-						"%u", static_cast<unsigned char> ( strtoul(str.c_str(), NULL, 10) ),
-					    L"%u", static_cast<unsigned char> ( wcstoul(str.c_str(), NULL, 10) ) );
+		const carrier_type lower = vbl + (is_even ? 0 : 1);
+		const carrier_type upper = vbr - (is_even ? 0 : 1);
 
-NUMERIC_STRING_CONVERTER(unsigned long, ulong_,
-						"%lu", strtoul(str.c_str(), NULL, 10),
-					    L"%lu", wcstoul(str.c_str(), NULL, 10));
+		shortest_decimal<T> result;
+		const carrier_type s = vb / 4;
+		bool found = false;
+		if(s >= 10)
+		{
+			const carrier_type sp = s / 10;
+			const bool up_inside = lower <= 40 * sp;
+			const bool wp_inside = 40 * sp + 40 <= upper;
+			if(up_inside != wp_inside)
+			{
+				result.significand = sp + (wp_inside ? 1 : 0);
+				result.exponent = k + 1;
+				found = true;
+			}
+		}
+		if(!found)
+		{
+			const bool u_inside = lower <= 4 * s;
+			const bool w_inside = 4 * s + 4 <= upper;
+			if(u_inside != w_inside)
+			{
+				result.significand = s + (w_inside ? 1 : 0);
+			}
+			else
+			{
+				const carrier_type mid = 4 * s + 2;
+				const bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+				result.significand = s + (round_up ? 1 : 0);
+			}
+			result.exponent = k;
+		}
 
-NUMERIC_STRING_CONVERTER(long long, longlong_,
-						"%lld", _atoi64(str.c_str()),
-					    L"%lld", _wtoi64(str.c_str()));
+		while(result.significand % 10 == 0)
+		{
+			result.significand /= 10;
+			++result.exponent;
+		}
+		return result;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write ascii literal
+	 * @return one past the last character written
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	inline CharT* write_literal(CharT* out, const char* literal)
+	{
+		while(*literal)
+		{
+			*out++ = static_cast<CharT>(*literal++);
+		}
+		return out;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write decimal (significand * 10^exponent)
+	 * @return one past the last character written
+	 * @param[in]	out : output
+	 * @param[in]	significand : decimal significand
+	 * @param[in]	exponent : decimal exponent
+	 * @param[in]	precision : precision of printf %g style layout
+	 *
+	 *	the layout follows printf "%.*g" with the given precision, but only the necessary digits are written.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename UInt>
+	inline CharT* write_decimal(CharT* out, UInt significand, int exponent, int precision)
+	{
+		const int digits = count_digits(significand);
+		const int scientific_exponent = digits - 1 + exponent;
 
-NUMERIC_STRING_CONVERTER(unsigned long long, ulonglong_,
-						"%llu", _strtoui64(str.c_str(), NULL, 10),
-					    L"%llu", _wcstoui64(str.c_str(), NULL, 10));
+		if(scientific_exponent < -4 || scientific_exponent >= precision)
+		{
+			// d.ddde+XX
+			write_digits(out + 1 + digits, significand);
+			out[0] = out[1];
+			if(digits > 1)
+			{
+				out[1] = static_cast<CharT>('.');
+				out += digits + 1;
+			}
+			else
+			{
+				out += 1;
+			}
+			*out++ = static_cast<CharT>('e');
+			*out++ = static_cast<CharT>(scientific_exponent < 0 ? '-' : '+');
+			const unsigned int exponent_magnitude = static_cast<unsigned int>(scientific_exponent < 0 ? -scientific_exponent : scientific_exponent);
+			if(exponent_magnitude < 10)
+			{
+				*out++ = static_cast<CharT>('0');
+			}
+			const int exponent_digits = count_digits(exponent_magnitude);
+			write_digits(out + exponent_digits, exponent_magnitude);
+			return out + exponent_digits;
+		}
+		if(exponent >= 0)
+		{
+			// ddd000
+			write_digits(out + digits, significand);
+			out += digits;
+			for(int i = 0; i < exponent; ++i)
+			{
+				*out++ = static_cast<CharT>('0');
+			}
+			return out;
+		}
+		if(scientific_exponent >= 0)
+		{
+			// ddd.ddd
+			const int integer_digits = scientific_exponent + 1;
+			write_digits(out + 1 + digits, significand);
+			for(int i = 0; i < integer_digits; ++i)
+			{
+				out[i] = out[i + 1];
+			}
+			out[integer_digits] = static_cast<CharT>('.');
+			return out + 1 + digits;
+		}
+		// 0.000ddd
+		*out++ = static_cast<CharT>('0');
+		*out++ = static_cast<CharT>('.');
+		for(int i = -1; i > scientific_exponent; --i)
+		{
+			*out++ = static_cast<CharT>('0');
+		}
+		write_digits(out + digits, significand);
+		return out + digits;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write floating point value in the shortest form which is read back to the same value
+	 * @return one past the last character written
+	 * @param[in]	out : output, which must have room for max_format_length<T>::value characters
+	 * @param[in]	value : floating point value
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	inline CharT* write_floating(CharT* out, T value)
+	{
+		typedef floating_traits<T> traits;
+		typedef typename traits::carrier_type carrier_type;
 
-NUMERIC_STRING_CONVERTER(double, double_,
-						"%g", atof(str.c_str()),
-					    L"%g", _wtof(str.c_str()));
+		carrier_type bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		const carrier_type significand = bits & ((static_cast<carrier_type>(1) << traits::significand_bits) - 1);
+		const int exponent = static_cast<int>((bits >> traits::significand_bits) & ((1u << traits::exponent_bits) - 1));
+		const bool negative = (bits >> (traits::significand_bits + traits::exponent_bits)) != 0;
 
-NUMERIC_STRING_CONVERTER(float, float_,
-						"%g", static_cast<float>(atof(str.c_str())),
-					    L"%g", static_cast<float>(_wtof(str.c_str())));
+		if(exponent == (1 << traits::exponent_bits) - 1)
+		{
+			if(significand != 0)
+			{
+				return write_literal(out, "nan");
+			}
+			return write_literal(out, negative ? "-inf" : "inf");
+		}
+		if(negative)
+		{
+			*out++ = static_cast<CharT>('-');
+		}
+		if(exponent == 0 && significand == 0)
+		{
+			*out++ = static_cast<CharT>('0');
+			return out;
+		}
+		const shortest_decimal<T> decimal = to_shortest_decimal<T>(significand, exponent);
+		return write_decimal(out, decimal.significand, decimal.exponent, traits::max_digits);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief append floating point value to string
+	 * @param[in,out]	dst : string appended to
+	 * @param[in]	src : input
+	 *
+	 *	the result has the fewest digits which are read back to exactly the same value.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType, typename T>
+	inline typename std::enable_if<std::is_floating_point<T>::value>::type
+	append_format(StdStrType& dst, const T& src)
+	{
+		typedef typename StdStrType::value_type char_type;
+		char_type buf[32];
+		dst.append(buf, write_floating(buf, src));
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write floating point value to buffer
+	 * @return one past the last character written, or NULL if the value does not fit in [first, last)
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	inline typename std::enable_if<std::is_floating_point<T>::value, CharT*>::type
+	write_format(CharT* first, CharT* last, const T& src)
+	{
+		CharT buf[32];
+		const CharT* const end = write_floating(buf, src);
+		if(last - first < end - buf)
+		{
+			return NULL;
+		}
+		return std::copy(static_cast<const CharT*>(buf), end, first);
+	}
+	/** the number of decimal digits of value */
+	constexpr size_t decimal_width(unsigned long long value)
+	{
+		return value < 10u ? 1 : 1 + decimal_width(value / 10u);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief texts of integers in [INTELLIGENT_CAST_SMALL_INTEGER_MIN, INTELLIGENT_CAST_SMALL_INTEGER_MAX]
+	 *
+	 *	the texts are held in one character array with a fixed stride, each followed by NUL, and their lengths in another array.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	struct small_integer_text
+	{
+		static const long long min = INTELLIGENT_CAST_SMALL_INTEGER_MIN;
+		static const long long max = INTELLIGENT_CAST_SMALL_INTEGER_MAX;
+		static_assert(min <= max && max >= 0, "INTELLIGENT_CAST_SMALL_INTEGER_MIN must not be greater than INTELLIGENT_CAST_SMALL_INTEGER_MAX.");
+		/** the number of texts */
+		static const size_t count = static_cast<size_t>(max - min + 1);
+		/** the longest text with its sign and NUL */
+		static const size_t stride = (min < 0 ? 1 : 0) + 1 +
+			decimal_width(min < 0 && 0ULL - static_cast<unsigned long long>(min) > static_cast<unsigned long long>(max) ? 0ULL - static_cast<unsigned long long>(min) : static_cast<unsigned long long>(max));
 
+		CharT characters[count * stride];
+		unsigned char lengths[count];
 
-#undef NUMERIC_STRING_CONVERTER
+		INTELLIGENT_CAST_CONSTEXPR14 small_integer_text()
+			: characters()
+			, lengths()
+		{
+			for(size_t i = 0; i < count; ++i)
+			{
+				const long long value = min + static_cast<long long>(i);
+				unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+				const size_t length = decimal_width(magnitude) + (value < 0 ? 1 : 0);
+				size_t position = i * stride + length;
+				do
+				{
+					characters[--position] = static_cast<CharT>('0' + magnitude % 10u);
+					magnitude /= 10u;
+				} while(magnitude != 0);
+				if(value < 0)
+				{
+					characters[--position] = static_cast<CharT>('-');
+				}
+				lengths[i] = static_cast<unsigned char>(length);
+			}
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief table of small_integer_text of each character type
+	 *
+	 *	with C++14 constexpr the table is a constant, which is built at compile time and referred without a guard.
+	 *	otherwise the same static storage is filled once at the first use, which is thread safe as a function local static.\n
+	 *	text() builds a std::basic_string of every entry at its first use, which allocates for each entry longer than
+	 *	the small string buffer (nearly all wide entries), so it is kept only for the reference to std::basic_string.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	struct small_integer_table
+	{
+		typedef small_integer_text<CharT> text_type;
+		static const long long min = text_type::min;
+		static const long long max = text_type::max;
 
-	/** a string type tag to be added to type_traits */
-	struct string_type{};
+#if defined(INTELLIGENT_CAST_HAS_CONSTEXPR14)
+		static constexpr text_type texts = text_type();
+		static const text_type& get()	{ return texts; }
+#else
+		static const text_type& get()
+		{
+			static const text_type texts;
+			return texts;
+		}
+#endif
 
-	/** a numeric type tag to be added to type_traits */
-	struct numeric_type{};
+		template<typename T>
+		static bool contains(const T& value)
+		{
+			return value < static_cast<T>(0) ?
+				static_cast<long long>(value) >= min :
+				static_cast<unsigned long long>(value) <= static_cast<unsigned long long>(max) && (min <= 0 || static_cast<long long>(value) >= min);
+		}
+		/** NUL terminated text of value, which must be contained */
+		template<typename T>
+		static const CharT* c_str(const T& value)
+		{
+			return get().characters + index(value) * text_type::stride;
+		}
+		template<typename T>
+		static size_t length(const T& value)
+		{
+			return get().lengths[index(value)];
+		}
+		template<typename T>
+		static const std::basic_string<CharT>& text(const T& value)
+		{
+			static const std::vector<std::basic_string<CharT> > strings = build();
+			return strings[index(value)];
+		}
 
+	private:
+		template<typename T>
+		static size_t index(const T& value)
+		{
+			return static_cast<size_t>(static_cast<long long>(value) - min);
+		}
+		static std::vector<std::basic_string<CharT> > build()
+		{
+			std::vector<std::basic_string<CharT> > strings(text_type::count);
+			for(size_t i = 0; i < text_type::count; ++i)
+			{
+				strings[i].assign(get().characters + i * text_type::stride, get().lengths[i]);
+			}
+			return strings;
+		}
+	};
+#if defined(INTELLIGENT_CAST_HAS_CONSTEXPR14)
+	template<typename CharT>
+	constexpr small_integer_text<CharT> small_integer_table<CharT>::texts;
+#endif
+	template<typename T, typename CharT>
+	struct numeric_backend;
 	//---------------------------------------------------------------------------
 	/**
-	 * @brief type traits for string converter
+	 * @brief format numeric value
+	 * @return StdStrType
+	 * @param[in]	src : input
 	 *
-	 * In the case of string, it must be specialized because imformation held is different from other types.
-	 * (mainly for defining a rule fo conversion of string type to other string type.)
+	 *	the length is known before the string is built, so the result is built with exactly one allocation.
 	 */
 	//---------------------------------------------------------------------------
+	template<typename StdStrType, typename T>
+	inline typename std::enable_if<std::is_arithmetic<T>::value, StdStrType>::type
+	format(const T& src)
+	{
+		StdStrType result;
+		numeric_backend<T, typename StdStrType::value_type>::append(result, src);
+		return result;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief the maximum number of characters which append_format writes for T
+	 *
+	 *	floating point value is at most a sign, max_digits10 digits, a point and an exponent such as "e-308".
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, bool IsIntegral = std::is_integral<T>::value>
+	struct max_format_length
+	{
+		static const size_t value = std::numeric_limits<T>::digits10 + 2;
+	};
+	template<typename T>
+	struct max_format_length<T, false>
+	{
+		static const size_t value = std::numeric_limits<T>::max_digits10 + (std::numeric_limits<T>::max_exponent10 >= 100 ? 7 : 6);
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief upper bound of the number of characters written by append_format
+	 *
+	 *	it is exact for integral value.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	inline typename std::enable_if<std::is_integral<T>::value, size_t>::type
+	format_length_bound(const T& src)
+	{
+		return integral_magnitude<T>(src).length;
+	}
+	template<typename T>
+	inline typename std::enable_if<std::is_floating_point<T>::value, size_t>::type
+	format_length_bound(const T&)
+	{
+		return max_format_length<T>::value;
+	}
+}	// End of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/**
+ * @brief string of at most N characters stored in place
+ * @param N capacity
+ * @param CharT character type
+ *
+ *	no memory is allocated, so a converted number can be hashed, compared or written without the allocator.\n
+ *	the characters are terminated by NUL. characters of string beyond the capacity are truncated,
+ *	and a numeric value is never truncated because the capacity is checked at compile time.
+ */
+//---------------------------------------------------------------------------
+template<size_t N, typename CharT = char>
+class inline_string
+{
+public:
+	typedef CharT value_type;
+	typedef const CharT* const_iterator;
+
+	inline_string()
+		: size_(0)
+	{
+		data_[0] = CharT();
+	}
+	inline_string(const CharT* first, const CharT* last)
+	{
+		assign(first, last);
+	}
+	/** text of numeric value, which is the same as intelligent_cast<std::basic_string<CharT> > */
+	template<typename T>
+	explicit inline_string(const T& value, typename std::enable_if<std::is_arithmetic<T>::value>::type* = 0)
+	{
+		static_assert(N >= intelligent_cast_detail::max_format_length<T>::value, "capacity of inline_string is too small for the numeric type. use small_text<T>.");
+		size_ = static_cast<size_t>(intelligent_cast_detail::write_format(data_, data_ + N, value) - data_);
+		data_[size_] = CharT();
+	}
+
+	void assign(const CharT* first, const CharT* last)
+	{
+		size_ = (std::min)(static_cast<size_t>(last - first), N);
+		std::char_traits<CharT>::copy(data_, first, size_);
+		data_[size_] = CharT();
+	}
+
+	const CharT* data() const				{ return data_; }
+	const CharT* c_str() const				{ return data_; }
+	size_t size() const						{ return size_; }
+	size_t length() const					{ return size_; }
+	bool empty() const						{ return size_ == 0; }
+	static size_t max_size()				{ return N; }
+	const_iterator begin() const			{ return data_; }
+	const_iterator end() const				{ return data_ + size_; }
+	CharT operator[](size_t index) const	{ return data_[index]; }
+
+	std::basic_string<CharT> str() const	{ return std::basic_string<CharT>(data_, size_); }
+#ifdef INTELLIGENT_CAST_HAS_STRING_VIEW
+	operator std::basic_string_view<CharT>() const	{ return std::basic_string_view<CharT>(data_, size_); }
+#endif
+
+private:
+	CharT data_[N + 1];
+	size_t size_;
+};
+
+template<size_t N, size_t M, typename CharT>
+inline bool operator==(const inline_string<N, CharT>& lhs, const inline_string<M, CharT>& rhs)
+{
+	return lhs.size() == rhs.size() && std::char_traits<CharT>::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+template<size_t N, size_t M, typename CharT>
+inline bool operator!=(const inline_string<N, CharT>& lhs, const inline_string<M, CharT>& rhs)
+{
+	return !(lhs == rhs);
+}
+template<size_t N, size_t M, typename CharT>
+inline bool operator<(const inline_string<N, CharT>& lhs, const inline_string<M, CharT>& rhs)
+{
+	return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1800
+//---------------------------------------------------------------------------
+/**
+ * @brief inline_string which holds the longest text of numeric type T
+ */
+//---------------------------------------------------------------------------
+template<typename T, typename CharT = char>
+using small_text = inline_string<intelligent_cast_detail::max_format_length<T>::value, CharT>;
+#endif
+
+//---------------------------------------------------------------------------
+/**
+ * @brief table of texts of small integers, which are referred without conversion
+ * @param CharT character type
+ *
+ *	the range is [INTELLIGENT_CAST_SMALL_INTEGER_MIN, INTELLIGENT_CAST_SMALL_INTEGER_MAX] ([0, 9999] by default).
+ *	the texts are one constant character array built at compile time with C++14 constexpr,
+ *	and c_str, length and view refer to it without any construction at runtime.\n
+ *	text(value) returns a reference to std::basic_string, and its first call builds a string of every entry
+ *	(about 9000 allocations for wchar_t of the default range). use it only where std::basic_string is required.\n
+ *	intelligent_cast returns a new string by value, so it does not use the table. refer to the table
+ *	where a conversion would build a string only to read it.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT = char>
+struct intelligent_cast_small_integer
+{
+	/** true if value is in the range of the table */
+	template<typename T>
+	static bool contains(const T& value)
+	{
+		static_assert(std::is_integral<T>::value, "small integer table is supported only for integral type.");
+		return intelligent_cast_detail::small_integer_table<CharT>::contains(value);
+	}
+	/** NUL terminated text of value in the constant table, value must be in the range of the table */
+	template<typename T>
+	static const CharT* c_str(const T& value)
+	{
+		static_assert(std::is_integral<T>::value, "small integer table is supported only for integral type.");
+		return intelligent_cast_detail::small_integer_table<CharT>::c_str(value);
+	}
+	/** length of text of value, which must be in the range of the table */
+	template<typename T>
+	static size_t length(const T& value)
+	{
+		static_assert(std::is_integral<T>::value, "small integer table is supported only for integral type.");
+		return intelligent_cast_detail::small_integer_table<CharT>::length(value);
+	}
+	/** text of value as std::basic_string, which must be in the range of the table. the first call allocates every entry */
+	template<typename T>
+	static const std::basic_string<CharT>& text(const T& value)
+	{
+		static_assert(std::is_integral<T>::value, "small integer table is supported only for integral type.");
+		return intelligent_cast_detail::small_integer_table<CharT>::text(value);
+	}
+#ifdef INTELLIGENT_CAST_HAS_STRING_VIEW
+	/** view of text of value in the constant table, value must be in the range of the table */
+	template<typename T>
+	static std::basic_string_view<CharT> view(const T& value)
+	{
+		return std::basic_string_view<CharT>(c_str(value), length(value));
+	}
+#endif
+};
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief check white space in the same way as isspace of "C" locale
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	constexpr bool is_space(CharT c)
+	{
+		return c == static_cast<CharT>(' ') || (c >= static_cast<CharT>('\t') && c <= static_cast<CharT>('\r'));
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief parse integral value from character range
+	 * @return one past the last character parsed, or first if no digit is found
+	 * @param[in]	first : first character
+	 * @param[in]	last : one past the last character
+	 * @param[out]	value : parsed value, 0 if no digit is found
+	 * @param[out]	out_of_range : true if the parsed number is not representable in T
+	 *
+	 *	leading white spaces and a sign are accepted like strtol, and parsing stops at the first non digit character or last.\n
+	 *	the range need not be terminated by NUL.
+	 *	range is checked while digits are accumulated, an out of range value saturates to the limit of T like strtol.
+	 *	a negative value for unsigned type is negated in T like strtoul, and reported as out of range.\n
+	 *	it is constexpr in C++14, and intelligent_cast_constant parses integral literals with it.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename CharT>
+	INTELLIGENT_CAST_CONSTEXPR14 const CharT* parse_integral(const CharT* first, const CharT* last, T& value, bool& out_of_range)
+	{
+		typedef typename unsigned_digits_type<T>::unsigned_type unsigned_type;
+		typedef typename unsigned_digits_type<T>::type digits_type;
+
+		const CharT* const begin = first;
+		while(first != last && is_space(*first))
+		{
+			++first;
+		}
+		bool negative = false;
+		if(first != last && (*first == static_cast<CharT>('-') || *first == static_cast<CharT>('+')))
+		{
+			negative = *first == static_cast<CharT>('-');
+			++first;
+		}
+
+		// magnitude of the minimum value of signed type is one more than the maximum value
+		const digits_type limit = static_cast<digits_type>(std::numeric_limits<T>::max()) +
+			(std::numeric_limits<T>::is_signed && negative ? 1u : 0u);
+		const digits_type limit_quotient = limit / 10u;
+		const unsigned int limit_remainder = static_cast<unsigned int>(limit % 10u);
+
+		const CharT* const digits_begin = first;
+		digits_type magnitude = 0;
+		bool overflow = false;
+		for(; first != last; ++first)
+		{
+			const unsigned int digit = static_cast<unsigned int>(*first - static_cast<CharT>('0'));
+			if(digit > 9u)
+			{
+				break;
+			}
+			if(magnitude < limit_quotient || (magnitude == limit_quotient && digit <= limit_remainder))
+			{
+				magnitude = magnitude * 10u + digit;
+			}
+			else
+			{
+				overflow = true;
+			}
+		}
+		if(first == digits_begin)
+		{
+			value = 0;
+			out_of_range = false;
+			return begin;
+		}
+		if(overflow)
+		{
+			magnitude = limit;
+		}
+		out_of_range = overflow || (!std::numeric_limits<T>::is_signed && negative && magnitude != 0);
+		if(overflow && !std::numeric_limits<T>::is_signed)
+		{
+			value = std::numeric_limits<T>::max();
+		}
+		else
+		{
+			value = static_cast<T>(static_cast<unsigned_type>(negative ? 0u - magnitude : magnitude));
+		}
+		return first;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief count leading zero bits of non zero value
+	 */
+	//---------------------------------------------------------------------------
+	inline int count_leading_zeros(unsigned long long val)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanReverse64(&index, val);
+		return 63 - static_cast<int>(index);
+#elif defined(__GNUC__)
+		return __builtin_clzll(val);
+#else
+		int count = 0;
+		while((val & (1ULL << 63)) == 0)
+		{
+			val <<= 1;
+			++count;
+		}
+		return count;
+#endif
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief floating point value in binary (significand * 2^exponent), before the sign is applied
+	 *
+	 *	significand holds the stored significand bits and exponent holds the stored (biased) exponent bits.
+	 */
+	//---------------------------------------------------------------------------
+	struct binary_float
+	{
+		unsigned long long significand;
+		int exponent;
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief compose floating point value from binary representation
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	inline T compose_floating(const binary_float& binary, bool negative)
+	{
+		typedef floating_traits<T> traits;
+		typedef typename traits::carrier_type carrier_type;
+
+		const carrier_type bits = static_cast<carrier_type>(binary.significand)
+			| (static_cast<carrier_type>(binary.exponent) << traits::significand_bits)
+			| (static_cast<carrier_type>(negative ? 1 : 0) << (traits::significand_bits + traits::exponent_bits));
+		T value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief significand of 10^q in 128 bits for Eisel-Lemire algorithm
+	 *
+	 *	the table entries are rounded toward zero, and rounded up for q in [-27, -1].
+	 *	this is the precision for which the algorithm is proven to never need a fallback.
+	 */
+	//---------------------------------------------------------------------------
+	inline uint128 lemire_pow10(int q)
+	{
+		const unsigned long long* entry = pow10_significand_table<>::values[q - pow10_significand_table<>::min_exponent];
+		uint128 g;
+		g.high = entry[0];
+		g.low = entry[1];
+		if(q >= -27 && q < 0)
+		{
+			++g.low;
+			if(g.low == 0) ++g.high;
+		}
+		return g;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief correctly rounded binary representation of w * 10^q
+	 * @return binary_float
+	 * @param[in]	q : decimal exponent
+	 * @param[in]	w : decimal significand
+	 *
+	 *	this is the Eisel-Lemire algorithm, as refined by Mushtak and Lemire so that no fallback is needed
+	 *	as long as w holds all the digits of the input.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	inline binary_float eisel_lemire(int q, unsigned long long w)
+	{
+		typedef floating_traits<T> traits;
+		const int infinite_exponent = (1 << traits::exponent_bits) - 1;
+		const int minimum_exponent = -traits::exponent_bias;
+
+		binary_float result;
+		if(w == 0 || q < traits::smallest_power_of_ten)
+		{
+			result.significand = 0;
+			result.exponent = 0;
+			return result;
+		}
+		if(q > traits::largest_power_of_ten)
+		{
+			result.significand = 0;
+			result.exponent = infinite_exponent;
+			return result;
+		}
+
+		const int lz = count_leading_zeros(w);
+		w <<= lz;
+
+		// only the bits needed to decide rounding are computed when the low word can not affect them
+		const uint128 g = lemire_pow10(q);
+		const unsigned long long precision_mask = 0xFFFFFFFFFFFFFFFFULL >> (traits::significand_bits + 3);
+		uint128 product = multiply_128(w, g.high);
+		if((product.high & precision_mask) == precision_mask)
+		{
+			const uint128 low_product = multiply_128(w, g.low);
+			product.low += low_product.high;
+			if(low_product.high > product.low) ++product.high;
+		}
+
+		const int upper_bit = static_cast<int>(product.high >> 63);
+		const int shift = upper_bit + 64 - traits::significand_bits - 3;
+		result.significand = product.high >> shift;
+		result.exponent = ((((152170 + 65536) * q) >> 16) + 63) + upper_bit - lz - minimum_exponent;
+
+		if(result.exponent <= 0)
+		{
+			// subnormal
+			if(-result.exponent + 1 >= 64)
+			{
+				result.significand = 0;
+				result.exponent = 0;
+				return result;
+			}
+			result.significand >>= -result.exponent + 1;
+			result.significand += result.significand & 1;
+			result.significand >>= 1;
+			result.exponent = result.significand < (1ULL << traits::significand_bits) ? 0 : 1;
+			result.significand &= ~(1ULL << traits::significand_bits);
+			return result;
+		}
+
+		// exactly halfway between two values, round to even
+		if(product.low <= 1 && q >= traits::min_round_to_even_exponent && q <= traits::max_round_to_even_exponent &&
+			(result.significand & 3) == 1 && (result.significand << shift) == product.high)
+		{
+			result.significand &= ~1ULL;
+		}
+		result.significand += result.significand & 1;
+		result.significand >>= 1;
+		if(result.significand >= (2ULL << traits::significand_bits))
+		{
+			result.significand = 1ULL << traits::significand_bits;
+			++result.exponent;
+		}
+		result.significand &= ~(1ULL << traits::significand_bits);
+		if(result.exponent >= infinite_exponent)
+		{
+			result.significand = 0;
+			result.exponent = infinite_exponent;
+		}
+		return result;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief arbitrary long decimal (0.digits * 10^decimal_point) used when the input has too many digits
+	 *
+	 *	digits which do not fit are dropped, and truncated records that a non zero digit was dropped.
+	 */
+	//---------------------------------------------------------------------------
+	struct long_decimal
+	{
+		static const int capacity = 800;
+		/** limit of decimal point beyond which the value is regarded as zero or infinity */
+		static const int point_range = 2047;
+		int num_digits;
+		int decimal_point;
+		bool truncated;
+		unsigned char digits[capacity];
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief remove trailing zeros of long decimal
+	 */
+	//---------------------------------------------------------------------------
+	inline void trim(long_decimal& d)
+	{
+		while(d.num_digits > 0 && d.digits[d.num_digits - 1] == 0)
+		{
+			--d.num_digits;
+		}
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief divide long decimal by 2^shift
+	 * @param[in,out]	d : long decimal
+	 * @param[in]	shift : shift amount, at most 60
+	 */
+	//---------------------------------------------------------------------------
+	inline void right_shift(long_decimal& d, int shift)
+	{
+		int read_index = 0;
+		int write_index = 0;
+		unsigned long long n = 0;
+		while((n >> shift) == 0)
+		{
+			if(read_index < d.num_digits)
+			{
+				n = 10 * n + d.digits[read_index++];
+			}
+			else if(n == 0)
+			{
+				return;
+			}
+			else
+			{
+				while((n >> shift) == 0)
+				{
+					n = 10 * n;
+					++read_index;
+				}
+				break;
+			}
+		}
+		d.decimal_point -= read_index - 1;
+		if(d.decimal_point < -long_decimal::point_range)
+		{
+			d.num_digits = 0;
+			d.decimal_point = 0;
+			d.truncated = false;
+			return;
+		}
+		const unsigned long long mask = (1ULL << shift) - 1;
+		while(read_index < d.num_digits)
+		{
+			const unsigned char digit = static_cast<unsigned char>(n >> shift);
+			n = 10 * (n & mask) + d.digits[read_index++];
+			d.digits[write_index++] = digit;
+		}
+		while(n > 0)
+		{
+			const unsigned char digit = static_cast<unsigned char>(n >> shift);
+			n = 10 * (n & mask);
+			if(write_index < long_decimal::capacity)
+			{
+				d.digits[write_index++] = digit;
+			}
+			else if(digit > 0)
+			{
+				d.truncated = true;
+			}
+		}
+		d.num_digits = write_index;
+		trim(d);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief multiply long decimal by 2^shift
+	 * @param[in,out]	d : long decimal
+	 * @param[in]	shift : shift amount, at most 60
+	 *
+	 *	the number of new digits is the number of digits of 2^shift,
+	 *	less one when the digits are lexicographically less than the digits of 5^shift.
+	 */
+	//---------------------------------------------------------------------------
+	inline void left_shift(long_decimal& d, int shift)
+	{
+		if(d.num_digits == 0)
+		{
+			return;
+		}
+
+		// digits of 5^shift, most significant first
+		unsigned char pow5[64];
+		int pow5_digits = 1;
+		pow5[0] = 1;
+		for(int i = 0; i < shift; ++i)
+		{
+			unsigned int carry = 0;
+			for(int j = pow5_digits - 1; j >= 0; --j)
+			{
+				const unsigned int x = pow5[j] * 5u + carry;
+				pow5[j] = static_cast<unsigned char>(x % 10);
+				carry = x / 10;
+			}
+			if(carry > 0)
+			{
+				std::memmove(pow5 + 1, pow5, pow5_digits);
+				pow5[0] = static_cast<unsigned char>(carry);
+				++pow5_digits;
+			}
+		}
+		int new_digits = shift + 1 - pow5_digits;
+		for(int i = 0; i < pow5_digits; ++i)
+		{
+			if(i >= d.num_digits || d.digits[i] != pow5[i])
+			{
+				if(i >= d.num_digits || d.digits[i] < pow5[i]) --new_digits;
+				break;
+			}
+		}
+
+		int read_index = d.num_digits - 1;
+		int write_index = d.num_digits - 1 + new_digits;
+		unsigned long long n = 0;
+		while(read_index >= 0)
+		{
+			n += static_cast<unsigned long long>(d.digits[read_index--]) << shift;
+			const unsigned long long quotient = n / 10;
+			const unsigned long long remainder = n - 10 * quotient;
+			if(write_index < long_decimal::capacity)
+			{
+				d.digits[write_index] = static_cast<unsigned char>(remainder);
+			}
+			else if(remainder > 0)
+			{
+				d.truncated = true;
+			}
+			n = quotient;
+			--write_index;
+		}
+		while(n > 0)
+		{
+			const unsigned long long quotient = n / 10;
+			const unsigned long long remainder = n - 10 * quotient;
+			if(write_index < long_decimal::capacity)
+			{
+				d.digits[write_index] = static_cast<unsigned char>(remainder);
+			}
+			else if(remainder > 0)
+			{
+				d.truncated = true;
+			}
+			n = quotient;
+			--write_index;
+		}
+		d.num_digits += new_digits;
+		if(d.num_digits > long_decimal::capacity)
+		{
+			d.num_digits = long_decimal::capacity;
+		}
+		d.decimal_point += new_digits;
+		trim(d);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief integer part of long decimal rounded to nearest even
+	 */
+	//---------------------------------------------------------------------------
+	inline unsigned long long round_integer(const long_decimal& d)
+	{
+		if(d.num_digits == 0 || d.decimal_point < 0)
+		{
+			return 0;
+		}
+		if(d.decimal_point > 18)
+		{
+			return 0xFFFFFFFFFFFFFFFFULL;
+		}
+		unsigned long long n = 0;
+		for(int i = 0; i < d.decimal_point; ++i)
+		{
+			n = 10 * n + (i < d.num_digits ? d.digits[i] : 0);
+		}
+		bool round_up = false;
+		if(d.decimal_point < d.num_digits)
+		{
+			const int next = d.digits[d.decimal_point];
+			round_up = next >= 5;
+			if(next == 5 && d.decimal_point + 1 == d.num_digits)
+			{
+				round_up = d.truncated || (d.decimal_point > 0 && (d.digits[d.decimal_point - 1] & 1) != 0);
+			}
+		}
+		return n + (round_up ? 1 : 0);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief correctly rounded binary representation of long decimal
+	 *
+	 *	this is the simple decimal conversion by Nigel Tao, the decimal is shifted by powers of two
+	 *	until it is normalized, then the significand is read from its integer part.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	inline binary_float long_decimal_to_binary(long_decimal& d)
+	{
+		typedef floating_traits<T> traits;
+		const int infinite_exponent = (1 << traits::exponent_bits) - 1;
+		const int minimum_exponent = -traits::exponent_bias;
+		const int max_shift = 60;
+		static const int powers[] = { 0, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59 };
+		const int num_powers = sizeof(powers) / sizeof(powers[0]);
+
+		binary_float zero = { 0, 0 };
+		binary_float infinity = { 0, infinite_exponent };
+		if(d.num_digits == 0 || d.decimal_point < -324)
+		{
+			return zero;
+		}
+		if(d.decimal_point >= 310)
+		{
+			return infinity;
+		}
+
+		int exponent2 = 0;
+		while(d.decimal_point > 0)
+		{
+			const int shift = d.decimal_point < num_powers ? powers[d.decimal_point] : max_shift;
+			right_shift(d, shift);
+			if(d.decimal_point < -long_decimal::point_range)
+			{
+				return zero;
+			}
+			exponent2 += shift;
+		}
+		// shift into [1/2, 1)
+		while(d.decimal_point <= 0)
+		{
+			int shift;
+			if(d.decimal_point == 0)
+			{
+				if(d.digits[0] >= 5) break;
+				shift = d.digits[0] < 2 ? 2 : 1;
+			}
+			else
+			{
+				shift = -d.decimal_point < num_powers ? powers[-d.decimal_point] : max_shift;
+			}
+			left_shift(d, shift);
+			if(d.decimal_point > long_decimal::point_range)
+			{
+				return infinity;
+			}
+			exponent2 -= shift;
+		}
+		// binary significand is in [1, 2)
+		--exponent2;
+		while(minimum_exponent + 1 > exponent2)
+		{
+			int shift = minimum_exponent + 1 - exponent2;
+			if(shift > max_shift) shift = max_shift;
+			right_shift(d, shift);
+			exponent2 += shift;
+		}
+		if(exponent2 - minimum_exponent >= infinite_exponent)
+		{
+			return infinity;
+		}
+
+		left_shift(d, traits::significand_bits + 1);
+		unsigned long long significand = round_integer(d);
+		if(significand >= (2ULL << traits::significand_bits))
+		{
+			right_shift(d, 1);
+			++exponent2;
+			significand = round_integer(d);
+			if(exponent2 - minimum_exponent >= infinite_exponent)
+			{
+				return infinity;
+			}
+		}
+		binary_float result;
+		result.exponent = exponent2 - minimum_exponent;
+		if(significand < (1ULL << traits::significand_bits))
+		{
+			--result.exponent;
+		}
+		result.significand = significand & ((1ULL << traits::significand_bits) - 1);
+		return result;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief append decimal digits to long decimal
+	 *
+	 *	leading zeros are not stored but move the decimal point instead.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	inline void append_digits(long_decimal& d, const CharT* first, const CharT* last)
+	{
+		for(; first != last; ++first)
+		{
+			const unsigned char digit = static_cast<unsigned char>(*first - static_cast<CharT>('0'));
+			if(d.num_digits == 0 && digit == 0)
+			{
+				--d.decimal_point;
+			}
+			else if(d.num_digits < long_decimal::capacity)
+			{
+				d.digits[d.num_digits++] = digit;
+			}
+			else if(digit != 0)
+			{
+				d.truncated = true;
+			}
+		}
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief check ascii word case-insensitively
+	 * @return one past the matched characters, or first if not matched
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	inline const CharT* match_word(const CharT* first, const CharT* last, const char* word)
+	{
+		const CharT* p = first;
+		for(; *word; ++word, ++p)
+		{
+			if(p == last || (*p | 0x20) != static_cast<CharT>(*word))
+			{
+				return first;
+			}
+		}
+		return p;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief digit value of character, or a value greater than 9 if it is not a digit
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	constexpr unsigned int digit_value(CharT c)
+	{
+		return static_cast<unsigned int>(c - static_cast<CharT>('0'));
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief parse floating point value from character range
+	 * @return one past the last character parsed, or first if no number is found
+	 * @param[in]	first : first character
+	 * @param[in]	last : one past the last character
+	 * @param[out]	value : parsed value, 0 if no number is found
+	 * @param[out]	out_of_range : true if a finite non zero number is rounded to infinity or zero
+	 *
+	 *	the syntax is the decimal form of strtod in "C" locale, including "inf", "infinity" and "nan".\n
+	 *	the result is correctly rounded to nearest even regardless of the number of digits.
+	 *	up to 19 significant digits are converted by Eisel-Lemire algorithm,
+	 *	longer input falls back to long_decimal only when its truncated digits change the result.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename CharT>
+	inline const CharT* parse_floating(const CharT* first, const CharT* last, T& value, bool& out_of_range)
+	{
+		typedef floating_traits<T> traits;
+		const unsigned long long min_nineteen_digits = 1000000000000000000ULL;
+
+		const CharT* const begin = first;
+		value = 0;
+		out_of_range = false;
+		while(first != last && is_space(*first))
+		{
+			++first;
+		}
+		bool negative = false;
+		if(first != last && (*first == static_cast<CharT>('-') || *first == static_cast<CharT>('+')))
+		{
+			negative = *first == static_cast<CharT>('-');
+			++first;
+		}
+
+		// significand
+		const CharT* const integer_first = first;
+		unsigned long long w = 0;
+		while(first != last && digit_value(*first) <= 9u)
+		{
+			w = 10 * w + digit_value(*first++);
+		}
+		const CharT* const integer_last = first;
+		const CharT* fraction_first = first;
+		const CharT* fraction_last = first;
+		if(first != last && *first == static_cast<CharT>('.'))
+		{
+			fraction_first = ++first;
+			while(first != last && digit_value(*first) <= 9u)
+			{
+				w = 10 * w + digit_value(*first++);
+			}
+			fraction_last = first;
+		}
+		int digit_count = static_cast<int>((integer_last - integer_first) + (fraction_last - fraction_first));
+		if(digit_count == 0)
+		{
+			const binary_float infinity = { 0, (1 << traits::exponent_bits) - 1 };
+			const binary_float nan = { 1ULL << (traits::significand_bits - 1), (1 << traits::exponent_bits) - 1 };
+			const CharT* p = match_word(integer_first, last, "inf");
+			if(p != integer_first)
+			{
+				value = compose_floating<T>(infinity, negative);
+				return match_word(p, last, "inity");
+			}
+			p = match_word(integer_first, last, "nan");
+			if(p != integer_first)
+			{
+				value = compose_floating<T>(nan, negative);
+				return p;
+			}
+			return begin;
+		}
+
+		// exponent
+		int explicit_exponent = 0;
+		if(first != last && (*first | 0x20) == static_cast<CharT>('e'))
+		{
+			const CharT* p = first + 1;
+			bool negative_exponent = false;
+			if(p != last && (*p == static_cast<CharT>('-') || *p == static_cast<CharT>('+')))
+			{
+				negative_exponent = *p == static_cast<CharT>('-');
+				++p;
+			}
+			if(p != last && digit_value(*p) <= 9u)
+			{
+				int exponent_number = 0;
+				for(; p != last && digit_value(*p) <= 9u; ++p)
+				{
+					if(exponent_number < 0x10000) exponent_number = 10 * exponent_number + static_cast<int>(digit_value(*p));
+				}
+				explicit_exponent = negative_exponent ? -exponent_number : exponent_number;
+				first = p;
+			}
+		}
+		const CharT* const end = first;
+		int exponent = explicit_exponent - static_cast<int>(fraction_last - fraction_first);
+
+		// keep the leading 19 significant digits when there are more
+		bool truncated = false;
+		if(digit_count > 19)
+		{
+			for(const CharT* p = integer_first; p != fraction_last && (*p == static_cast<CharT>('0') || *p == static_cast<CharT>('.')); ++p)
+			{
+				if(*p == static_cast<CharT>('0')) --digit_count;
+			}
+			if(digit_count > 19)
+			{
+				truncated = true;
+				w = 0;
+				const CharT* p = integer_first;
+				for(; p != integer_last && w < min_nineteen_digits; ++p)
+				{
+					w = 10 * w + digit_value(*p);
+				}
+				if(w >= min_nineteen_digits)
+				{
+					exponent += static_cast<int>(integer_last - p) + static_cast<int>(fraction_last - fraction_first);
+				}
+				else
+				{
+					for(p = fraction_first; p != fraction_last && w < min_nineteen_digits; ++p)
+					{
+						w = 10 * w + digit_value(*p);
+					}
+					exponent += static_cast<int>(fraction_last - p);
+				}
+			}
+		}
+
+		// exact when both significand and power of ten are exactly representable
+		if(!truncated && exponent >= -traits::max_exact_exponent && exponent <= traits::max_exact_exponent && w <= traits::max_exact_significand)
+		{
+			value = static_cast<T>(w);
+			value = exponent < 0 ? value / traits::exact_pow10(-exponent) : value * traits::exact_pow10(exponent);
+			value = negative ? -value : value;
+			return end;
+		}
+
+		binary_float binary = eisel_lemire<T>(exponent, w);
+		if(truncated && w != 0)
+		{
+			// the truncated digits may round the value up
+			const binary_float upper = eisel_lemire<T>(exponent, w + 1);
+			if(upper.significand != binary.significand || upper.exponent != binary.exponent)
+			{
+				long_decimal d;
+				d.num_digits = 0;
+				d.decimal_point = static_cast<int>(integer_last - integer_first) + explicit_exponent;
+				d.truncated = false;
+				append_digits(d, integer_first, integer_last);
+				append_digits(d, fraction_first, fraction_last);
+				trim(d);
+				binary = long_decimal_to_binary<T>(d);
+			}
+		}
+		out_of_range = binary.exponent == (1 << traits::exponent_bits) - 1 || (binary.exponent == 0 && binary.significand == 0 && w != 0);
+		value = compose_floating<T>(binary, negative);
+		return end;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief numeric conversion by the self-contained routines
+	 *
+	 *	append and write format T to text of CharT, and parse reads it back with the syntax and the errors of strtol and strtod.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename CharT, bool IsIntegral = std::is_integral<T>::value>
+	struct self_contained_backend
+	{
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const T& src)								{ append_format(dst, src); }
+		static CharT* write(CharT* first, CharT* last, const T& src)					{ return write_format(first, last, src); }
+		static const CharT* parse(const CharT* first, const CharT* last, T& value, bool& out_of_range)
+		{
+			return parse_integral(first, last, value, out_of_range);
+		}
+	};
+	template<typename T, typename CharT>
+	struct self_contained_backend<T, CharT, false>
+	{
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const T& src)								{ append_format(dst, src); }
+		static CharT* write(CharT* first, CharT* last, const T& src)					{ return write_format(first, last, src); }
+		static const CharT* parse(const CharT* first, const CharT* last, T& value, bool& out_of_range)
+		{
+			return parse_floating(first, last, value, out_of_range);
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief numeric conversion of T and text of CharT, selected at compile time
+	 *
+	 *	the self-contained routines are used unless a specialization for T is generated from INTELLIGENT_CAST_NUMERIC_TYPES.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename CharT>
+	struct numeric_backend : self_contained_backend<T, CharT>
+	{
+	};
+#if defined(INTELLIGENT_CAST_HAS_CHARCONV)
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief numeric conversion of text of char by std::to_chars and std::from_chars
+	 *
+	 *	the text and the accepted syntax are the same as self_contained_backend.
+	 *	white spaces and a sign are read here, because std::from_chars accepts neither a leading space nor '+'.
+	 *	an out of range integral value saturates like strtol.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, bool IsIntegral = std::is_integral<T>::value>
+	struct charconv_backend
+	{
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const T& src)
+		{
+			char buf[max_format_length<T>::value];
+			dst.append(buf, std::to_chars(buf, buf + sizeof(buf), src).ptr);
+		}
+		static char* write(char* first, char* last, const T& src)
+		{
+			const std::to_chars_result result = std::to_chars(first, last, src);
+			return result.ec == std::errc() ? result.ptr : NULL;
+		}
+		static const char* parse(const char* first, const char* last, T& value, bool& out_of_range)
+		{
+			typedef typename std::make_unsigned<T>::type unsigned_type;
+
+			const char* const begin = first;
+			while(first != last && is_space(*first))
+			{
+				++first;
+			}
+			bool negative = false;
+			if(first != last && (*first == '-' || *first == '+'))
+			{
+				negative = *first == '-';
+				++first;
+			}
+			// magnitude of the minimum value of signed type is one more than the maximum value
+			const unsigned_type limit = static_cast<unsigned_type>(static_cast<unsigned_type>(std::numeric_limits<T>::max()) +
+				(std::numeric_limits<T>::is_signed && negative ? 1u : 0u));
+			unsigned_type magnitude = 0;
+			const std::from_chars_result result = std::from_chars(first, last, magnitude);
+			if(result.ptr == first)
+			{
+				value = 0;
+				out_of_range = false;
+				return begin;
+			}
+			const bool overflow = result.ec == std::errc::result_out_of_range || magnitude > limit;
+			if(overflow)
+			{
+				magnitude = limit;
+			}
+			out_of_range = overflow || (!std::numeric_limits<T>::is_signed && negative && magnitude != 0);
+			if(overflow && !std::numeric_limits<T>::is_signed)
+			{
+				value = std::numeric_limits<T>::max();
+			}
+			else
+			{
+				value = static_cast<T>(static_cast<unsigned_type>(negative ? 0u - magnitude : magnitude));
+			}
+			return result.ptr;
+		}
+	};
+	// floating point value is laid out by write_decimal from the shortest digits of std::to_chars
+	template<typename T>
+	struct charconv_backend<T, false>
+	{
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const T& src)
+		{
+			char buf[32];
+			dst.append(buf, write_shortest(buf, src));
+		}
+		static char* write(char* first, char* last, const T& src)
+		{
+			char buf[32];
+			const char* const end = write_shortest(buf, src);
+			if(last - first < end - buf)
+			{
+				return NULL;
+			}
+			return std::copy(static_cast<const char*>(buf), end, first);
+		}
+		static const char* parse(const char* first, const char* last, T& value, bool& out_of_range)
+		{
+			const char* number = first;
+			while(number != last && is_space(*number))
+			{
+				++number;
+			}
+			const bool negative = number != last && *number == '-';
+			if(number != last && (*number == '-' || *number == '+'))
+			{
+				++number;
+			}
+			// "inf", "nan" and a value rounded to infinity or zero are left to parse_floating
+			if(number == last || (digit_value(*number) > 9u && *number != '.'))
+			{
+				return parse_floating(first, last, value, out_of_range);
+			}
+			const std::from_chars_result result = std::from_chars(number, last, value);
+			if(result.ec == std::errc::result_out_of_range)
+			{
+				return parse_floating(first, last, value, out_of_range);
+			}
+			out_of_range = false;
+			if(result.ec != std::errc())
+			{
+				value = 0;
+				return first;
+			}
+			value = negative ? -value : value;
+			return result.ptr;
+		}
+
+	private:
+		static char* write_shortest(char* out, const T& src)
+		{
+			if(!(src != 0 && src - src == 0))
+			{
+				// zero, infinity and nan
+				return write_floating(out, src);
+			}
+			char digits[32];
+			const char* const end = std::to_chars(digits, digits + sizeof(digits), src, std::chars_format::scientific).ptr;
+			const char* p = digits;
+			if(*p == '-')
+			{
+				*out++ = '-';
+				++p;
+			}
+			unsigned long long significand = 0;
+			int digit_count = 0;
+			for(; *p != 'e'; ++p)
+			{
+				if(*p != '.')
+				{
+					significand = significand * 10 + digit_value(*p);
+					++digit_count;
+				}
+			}
+			const bool negative_exponent = p[1] == '-';
+			int exponent = 0;
+			for(p += 2; p != end; ++p)
+			{
+				exponent = exponent * 10 + static_cast<int>(digit_value(*p));
+			}
+			return write_decimal(out, significand, (negative_exponent ? -exponent : exponent) - (digit_count - 1), floating_traits<T>::max_digits);
+		}
+	};
+#endif
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief character range of NUL terminated string
+	 */
+	//---------------------------------------------------------------------------
+	inline std::pair<const char*, const char*> char_range(const char* str)
+	{
+		return std::make_pair(str, str + std::strlen(str));
+	}
+	inline std::pair<const wchar_t*, const wchar_t*> char_range(const wchar_t* str)
+	{
+		return std::make_pair(str, str + std::wcslen(str));
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief convert character range to string
+	 * @return StdStrType
+	 * @param[in]	first : first character
+	 * @param[in]	last : one past the last character
+	 *
+	 *	characters are copied directly when the character type is same as StdStrType.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType, typename CharT>
+	inline typename std::enable_if<std::is_same<typename StdStrType::value_type, CharT>::value, StdStrType>::type
+	range_to_string(const CharT* first, const CharT* last)
+	{
+		return StdStrType(first, last);
+	}
+	template<typename StdStrType, typename CharT>
+	inline typename std::enable_if<!std::is_same<typename StdStrType::value_type, CharT>::value, StdStrType>::type
+	range_to_string(const CharT* first, const CharT* last)
+	{
+		return transcode<StdStrType>(first, last);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief append character range to string
+	 * @param[in,out]	dst : string appended to
+	 * @param[in]	first : first character
+	 * @param[in]	last : one past the last character
+	 *
+	 *	characters are appended directly when the character type is same as StdStrType.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType, typename CharT>
+	inline typename std::enable_if<std::is_same<typename StdStrType::value_type, CharT>::value>::type
+	append_range(StdStrType& dst, const CharT* first, const CharT* last)
+	{
+		dst.append(first, last);
+	}
+	template<typename StdStrType, typename CharT>
+	inline typename std::enable_if<!std::is_same<typename StdStrType::value_type, CharT>::value>::type
+	append_range(StdStrType& dst, const CharT* first, const CharT* last)
+	{
+		typedef transcoder<typename StdStrType::value_type, CharT> transcoder_type;
+		const CharT* valid_last;
+		const size_t length = transcoder_type::length(first, last, valid_last);
+		if(length != 0)
+		{
+			const size_t size = dst.size();
+			dst.resize(size + length);
+			transcoder_type::write(first, valid_last, &dst[0] + size);
+		}
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief upper bound of the number of characters of OutCharT converted from character range
+	 *
+	 *	a wide character may be converted to several UTF-8 bytes, otherwise one character is converted to at most one.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename OutCharT, typename CharT>
+	inline typename std::enable_if<std::is_same<OutCharT, CharT>::value, size_t>::type
+	range_length_bound(const CharT* first, const CharT* last)
+	{
+		return static_cast<size_t>(last - first);
+	}
+	template<typename OutCharT, typename CharT>
+	inline typename std::enable_if<!std::is_same<OutCharT, CharT>::value, size_t>::type
+	range_length_bound(const CharT* first, const CharT* last)
+	{
+		return static_cast<size_t>(last - first) * transcoder<OutCharT, CharT>::max_length;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write character range to buffer
+	 * @return one past the last character written, or NULL if the characters do not fit in [out_first, out_last)
+	 * @param[in]	out_first : first character of buffer
+	 * @param[in]	out_last : one past the last character of buffer
+	 * @param[in]	first : first character
+	 * @param[in]	last : one past the last character
+	 */
+	//---------------------------------------------------------------------------
+	template<typename OutCharT, typename CharT>
+	inline typename std::enable_if<std::is_same<OutCharT, CharT>::value, OutCharT*>::type
+	write_range(OutCharT* out_first, OutCharT* out_last, const CharT* first, const CharT* last)
+	{
+		if(out_last - out_first < last - first)
+		{
+			return NULL;
+		}
+		return std::copy(first, last, out_first);
+	}
+	template<typename OutCharT, typename CharT>
+	inline typename std::enable_if<!std::is_same<OutCharT, CharT>::value, OutCharT*>::type
+	write_range(OutCharT* out_first, OutCharT* out_last, const CharT* first, const CharT* last)
+	{
+		typedef transcoder<OutCharT, CharT> transcoder_type;
+		const CharT* valid_last;
+		if(static_cast<size_t>(out_last - out_first) < transcoder_type::length(first, last, valid_last))
+		{
+			return NULL;
+		}
+		return transcoder_type::write(first, valid_last, out_first);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief conversion rule for convertiong string to another type of string
+	 *
+	 *	this avoids unnecessary copying when From type and To type are same string type.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename From, typename To>
+	struct string_conversion_rules
+	{
+		typedef To result_type;
+		static result_type convert(const From& from){return interconvert_string(from);} 
+	};
+	template<typename From>
+	struct string_conversion_rules<From, From>
+	{
+		typedef const From& result_type;
+		static result_type convert(result_type from){return from;}
+	};
+
+//---------------------------------------------------------------------------
+/**
+ * @brief   this macro defines converter class for converting numeric value to string, or converting string to numeric value
+ * @param   type		 numeric value type
+ * @param   namespace_ 	 namespace name for this type of conversion
+ * @param   c_parse 	 parse function for character range [first, last) of char, which stores value and out_of_range and returns the end of parsed characters
+ * @param   w_parse 	 parse function for character range [first, last) of wchar_t, same as c_parse
+ * @see     string_converter
+ * 
+ *   numeric value is converted to string by format function which is overloaded for integral and floating point type.\n
+ *   string is converted to numeric value through the character range, so no string is built for parsing.
+ *
+ *   (example) converter for int
+ * @code
+	NUMERIC_STRING_CONVERTER(
+						int, int_,	// any namespace is ok
+						parse_integral(first, last, value, out_of_range),		// for string
+						parse_integral(first, last, value, out_of_range)		// for wstring
+						);
+
+ * @endcode
+ */
+//---------------------------------------------------------------------------
+#define NUMERIC_STRING_CONVERTER(type, namespace_, \
+								c_parse, w_parse) \
+	template<typename> struct namespace_##char_traits \
+	{ \
+	}; \
+	template<> struct namespace_##char_traits<char> \
+	{ \
+		static const char*		parse(const char* first, const char* last, type& value, bool& out_of_range)	{ return c_parse; } \
+	}; \
+	template<> struct namespace_##char_traits<wchar_t> \
+	{ \
+		static const wchar_t*	parse(const wchar_t* first, const wchar_t* last, type& value, bool& out_of_range)	{ return w_parse; } \
+	};\
+	template<typename StdStrType> \
+	struct string_converter<type, StdStrType> : string_convertible\
+	{ \
+	typedef StdStrType std_str_type;\
+	typedef type value_type; \
+	typedef typename StdStrType::value_type char_type;\
+	static std_str_type to_string(const value_type& val)	{ return format<std_str_type>(val); }\
+	static const char_type* parse(const char_type* first, const char_type* last, value_type& value, bool& out_of_range) \
+	{ \
+		return namespace_##char_traits<char_type>::parse(first, last, value, out_of_range); \
+	} \
+	static value_type get_value(const char_type* first, const char_type* last) \
+	{ \
+		value_type value; \
+		bool out_of_range; \
+		parse(first, last, value, out_of_range); \
+		return value; \
+	} \
+	static value_type get_value(const StdStrType& str)	{ return get_value(str.data(), str.data() + str.size()); } \
+	} \
+
+	struct string_unconvertible
+	{
+		static const bool is_convertible = false;
+	};
+
+	struct string_convertible
+	{
+		static const bool is_convertible = true;
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter class for string and numeric value
+	 * @param T string or numeric value or user defined class
+	 * @param StdStrType string class that must be std::string or std::wstring
+	 *
+	 *	this class must be specialized. Specialized classes for numeric value are defined as macro above.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename StdStrType>
+	struct string_converter : string_unconvertible
+	{
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter specialized for conversion between argment string type and std::string type.
+	 * @param String converted string type that must be std::string or std::wstring
+	 *
+	 *	to_string function provides argment type to std::string.\n
+	 *  reduction function provides std::string to argment type.\n
+	 *  range function provides characters of argment without copying.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType>
+	struct string_converter<std::string, StdStrType> : string_convertible
+	{
+		typedef std::string value_type, handle_type;
+		typedef typename string_conversion_rules<value_type, StdStrType>::result_type std_str_type;
+		typedef std::pair<const char*, const char*> range_type;
+		typedef typename string_conversion_rules<StdStrType, value_type>::result_type reduction_type;
+		static std_str_type to_string(const value_type& val){ return string_conversion_rules<value_type, StdStrType>::convert(val); };
+		static range_type range(const value_type& val){ return range_type(val.data(), val.data() + val.size()); }
+		static reduction_type reduction(const StdStrType& string){ return string_converter<StdStrType, value_type>::to_string(string); }
+	
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter specialized for conversion between argment string type and std::wstring type.
+	 * @param String converted string type that must be std::string or std::wstring
+	 *
+	 *	to_string function provides argment type to std::wstring.\n
+	 *  reduction function provides std::wstring to argment type.\n
+	 *  range function provides characters of argment without copying.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType>
+	struct string_converter<std::wstring, StdStrType> : string_convertible
+	{
+		typedef std::wstring value_type, handle_type;
+		typedef typename string_conversion_rules<value_type, StdStrType>::result_type std_str_type;
+		typedef std::pair<const wchar_t*, const wchar_t*> range_type;
+		typedef typename string_conversion_rules<StdStrType, value_type>::result_type reduction_type;
+		static std_str_type to_string(const value_type& val){ return string_conversion_rules<value_type, StdStrType>::convert(val); };
+		static range_type range(const value_type& val){ return range_type(val.data(), val.data() + val.size()); }
+		static reduction_type reduction(const StdStrType& string){ return string_converter<StdStrType, value_type>::to_string(string); }
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter specialized for conversion between argment string type and const wchar_t*.
+	 * @param StdStrType a type which is converted to and which must be std::string or std::wstring
+	 *
+	 *	to_string function provides argment type to std::wstring.\n
+	 *  reduction function provides std::wstring to argment type.\n
+	 *  range function provides characters of argment without copying.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType>
+	struct string_converter<const wchar_t*, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef const wchar_t* value_type;
+		typedef value_type reduction_type;
+		typedef std::wstring handle_type;
+		typedef std::pair<const wchar_t*, const wchar_t*> range_type;
+		static std_str_type to_string(value_type const val)	{ const range_type chars = char_range(val); return range_to_string<std_str_type>(chars.first, chars.second); };
+		static range_type range(value_type const val)			{ return char_range(val); }
+		static reduction_type reduction(const StdStrType& string){ return string.c_str(); }
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter specialized for conversion between argment string type and const char* type.
+	 * @param StdStrType a type which is converted to and which must be std::string or std::wstring
+	 *
+	 *	to_string function provides argment type to std::string.\n
+	 *  reduction function provides std::string to argment type.\n
+	 *  range function provides characters of argment without copying.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType>
+	struct string_converter<const char*, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef const char* value_type;
+		typedef value_type reduction_type;
+		typedef std::string handle_type;
+		typedef std::pair<const char*, const char*> range_type;
+		static std_str_type to_string(value_type const val)		{ const range_type chars = char_range(val); return range_to_string<std_str_type>(chars.first, chars.second); };
+		static range_type range(value_type const val)				{ return char_range(val); }
+		static reduction_type reduction(const StdStrType& string){ return string.c_str(); }
+	};
+#ifdef INTELLIGENT_CAST_HAS_STRING_VIEW
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter specialized for conversion between argment string type and std::string_view / std::wstring_view.
+	 * @param StdStrType a type which is converted to and which must be std::string or std::wstring
+	 *
+	 *	to_string function provides argment type to StdStrType.\n
+	 *  range function provides characters of argment without copying.\n
+	 *  string view can not own converted characters, so it is only supported as a type converted from.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType>
+	struct string_converter<std::string_view, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef std::string_view value_type;
+		typedef std::string handle_type;
+		typedef std::pair<const char*, const char*> range_type;
+		static std_str_type to_string(value_type const val)		{ return range_to_string<std_str_type>(val.data(), val.data() + val.size()); }
+		static range_type range(value_type const val)				{ return range_type(val.data(), val.data() + val.size()); }
+	};
+	template<typename StdStrType>
+	struct string_converter<std::wstring_view, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef std::wstring_view value_type;
+		typedef std::wstring handle_type;
+		typedef std::pair<const wchar_t*, const wchar_t*> range_type;
+		static std_str_type to_string(value_type const val)		{ return range_to_string<std_str_type>(val.data(), val.data() + val.size()); }
+		static range_type range(value_type const val)				{ return range_type(val.data(), val.data() + val.size()); }
+	};
+#endif
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter specialized for conversion between argment string type and std::basic_string with other allocator or traits.
+	 * @param StdStrType a type which is converted to and which must be std::string or std::wstring
+	 *
+	 *	to_string function provides argment type to StdStrType.\n
+	 *  reduction function provides StdStrType to argment type, which uses the default constructed allocator.\n
+	 *  range function provides characters of argment without copying.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename Traits, typename Alloc, typename StdStrType>
+	struct string_converter<std::basic_string<CharT, Traits, Alloc>, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef std::basic_string<CharT, Traits, Alloc> value_type, reduction_type;
+		typedef std::basic_string<CharT> handle_type;
+		typedef std::pair<const CharT*, const CharT*> range_type;
+		static std_str_type to_string(value_type const& val)		{ return range_to_string<std_str_type>(val.data(), val.data() + val.size()); }
+		static range_type range(value_type const& val)				{ return range_type(val.data(), val.data() + val.size()); }
+		static reduction_type reduction(const StdStrType& string)	{ return range_to_string<reduction_type>(string.data(), string.data() + string.size()); }
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter specialized for conversion between argment string type and inline_string.
+	 * @param StdStrType a type which is converted to and which must be std::string or std::wstring
+	 *
+	 *	to_string function provides argment type to StdStrType.\n
+	 *  reduction function provides std::basic_string of the same character type to argment type, which is truncated to the capacity.\n
+	 *  range function provides characters of argment without copying.
+	 */
+	//---------------------------------------------------------------------------
+	template<size_t N, typename CharT, typename StdStrType>
+	struct string_converter<inline_string<N, CharT>, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef inline_string<N, CharT> value_type, reduction_type;
+		typedef std::basic_string<CharT> handle_type;
+		typedef std::pair<const CharT*, const CharT*> range_type;
+		static std_str_type to_string(value_type const& val)		{ return range_to_string<std_str_type>(val.data(), val.data() + val.size()); }
+		static range_type range(value_type const& val)				{ return range_type(val.data(), val.data() + val.size()); }
+		static reduction_type reduction(const StdStrType& string)	{ return reduction_type(string.data(), string.data() + string.size()); }
+	};
+#ifdef _AFX
+	template<typename StdStrType>
+	struct string_converter<CStringA, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef CStringA value_type, reduction_type;
+		typedef std::pair<const char*, const char*> range_type;
+		typedef std::string handle_type;	
+		static std_str_type to_string(value_type const& val)		{ return string_converter<handle_type, StdStrType>::to_string(val.GetString()); };
+		static range_type range(value_type const& val)				{ return range_type(val.GetString(), val.GetString() + val.GetLength()); }
+		static reduction_type reduction(const StdStrType& string)	{ return reduction_type( string_converter<StdStrType, handle_type>::to_string(string).c_str() ); }
+	};
+	template<typename StdStrType>
+	struct string_converter<CStringW, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef CStringW value_type, reduction_type;
+		typedef std::pair<const wchar_t*, const wchar_t*> range_type;
+		typedef std::wstring handle_type;	
+		static std_str_type to_string(value_type const& val)		{ return string_converter<handle_type, StdStrType>::to_string(val.GetString()); };
+		static range_type range(value_type const& val)				{ return range_type(val.GetString(), val.GetString() + val.GetLength()); }
+		static reduction_type reduction(const StdStrType& string)	{ return reduction_type( string_converter<StdStrType, handle_type>::to_string(string).c_str() ); }
+	};
+#endif
+
+//---------------------------------------------------------------------------
+// numeric types which have a string converter, X(type, name) for each.
+// the converters below and the runtime dispatch of "IntelligentCastDispatch.h" are generated from this list.
+// when INTELLIGENT_CAST_HAS_CHARCONV is defined, text of char is converted by std::to_chars and std::from_chars.
+//---------------------------------------------------------------------------
+#define INTELLIGENT_CAST_NUMERIC_TYPES(X) \
+	X(char, char_) \
+	X(unsigned char, uchar_) \
+	X(short, short_) \
+	X(unsigned short, ushort_) \
+	X(int, int_) \
+	X(unsigned int, uint_) \
+	X(long, long_) \
+	X(unsigned long, ulong_) \
+	X(long long, longlong_) \
+	X(unsigned long long, ulonglong_) \
+	X(float, float_) \
+	X(double, double_)
+
+#if defined(INTELLIGENT_CAST_HAS_CHARCONV)
+#define INTELLIGENT_CAST_NUMERIC_BACKEND(type, name) \
+	template<> struct numeric_backend<type, char> : charconv_backend<type> {};
+
+INTELLIGENT_CAST_NUMERIC_TYPES(INTELLIGENT_CAST_NUMERIC_BACKEND)
+
+#undef INTELLIGENT_CAST_NUMERIC_BACKEND
+#endif
+
+#define INTELLIGENT_CAST_NUMERIC_CONVERTER(type, name) \
+	NUMERIC_STRING_CONVERTER(type, name, \
+						(numeric_backend<type, char>::parse(first, last, value, out_of_range)), \
+						(numeric_backend<type, wchar_t>::parse(first, last, value, out_of_range)));
+
+INTELLIGENT_CAST_NUMERIC_TYPES(INTELLIGENT_CAST_NUMERIC_CONVERTER)
+
+#undef INTELLIGENT_CAST_NUMERIC_CONVERTER
+#undef NUMERIC_STRING_CONVERTER
+
+	/** a string type tag to be added to type_traits */
+	struct string_type{};
+
+	/** a numeric type tag to be added to type_traits */
+	struct numeric_type{};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief type traits for string converter
+	 *
+	 * In the case of string, it must be specialized because imformation held is different from other types.
+	 * (mainly for defining a rule fo conversion of string type to other string type.)
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	struct type_traits
+	{
+		typedef T original_type, tagged_type;
+		typedef numeric_type type_info;
+	};
+
+	template<>
+	struct type_traits<const char*>
+	{
+		typedef const char* original_type;
+		typedef original_type tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::string> std_str_converter;
+	};
+
+	template<>
+	struct type_traits<const wchar_t*>
+	{
+		typedef const wchar_t* original_type;
+		typedef original_type tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::wstring> std_str_converter;
+	};
+
+	template<size_t t>
+	struct type_traits<const char[t]>
+	{
+		typedef const char* original_type;
+		typedef original_type tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::string> std_str_converter;
+	};
+
+	template<size_t t>
+	struct type_traits<const wchar_t[t]>
+	{
+		typedef const wchar_t* original_type;
+		typedef original_type tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::wstring> std_str_converter;
+	};
+
+	template<>
+	struct type_traits<char*> : type_traits<const char*>
+	{
+	};
+
+	template<>
+	struct type_traits<wchar_t*> : type_traits<const wchar_t*>
+	{
+	};
+
+	// a string literal may be deduced as an array of non const characters
+	template<size_t t>
+	struct type_traits<char[t]> : type_traits<const char[t]>
+	{
+	};
+
+	template<size_t t>
+	struct type_traits<wchar_t[t]> : type_traits<const wchar_t[t]>
+	{
+	};
+
+	template<>
+	struct type_traits<std::string>
+	{
+		typedef std::string original_type, tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, tagged_type> std_str_converter;
+	};
+
+	template<>
+	struct type_traits<std::wstring>
+	{
+		typedef std::wstring original_type, tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, tagged_type> std_str_converter;
+	};
+
+#ifdef INTELLIGENT_CAST_HAS_STRING_VIEW
+
+	template<>
+	struct type_traits<std::string_view>
+	{
+		typedef std::string_view original_type, tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::string> std_str_converter;
+	};
+
+	template<>
+	struct type_traits<std::wstring_view>
+	{
+		typedef std::wstring_view original_type, tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::wstring> std_str_converter;
+	};
+
+#endif
+
+	// std::basic_string with other allocator (such as std::pmr::string) or traits
+	template<typename CharT, typename Traits, typename Alloc>
+	struct type_traits<std::basic_string<CharT, Traits, Alloc> >
+	{
+		typedef std::basic_string<CharT, Traits, Alloc> original_type, tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::basic_string<CharT> > std_str_converter;
+	};
+
+	template<size_t N, typename CharT>
+	struct type_traits<inline_string<N, CharT> >
+	{
+		typedef inline_string<N, CharT> original_type, tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::basic_string<CharT> > std_str_converter;
+	};
+
+#ifdef _AFX
+
+	template<>
+	struct type_traits<CStringA>
+	{
+		typedef CStringA original_type, tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::string> std_str_converter;
+	};
+
+	template<>
+	struct type_traits<CStringW>
+	{
+		typedef CStringW original_type, tagged_type;
+		typedef string_type type_info;
+		typedef string_converter<tagged_type, std::wstring> std_str_converter;
+	};
+
+#endif
+
+	// "From" instance is cast to the string type of "To", and reduced to "To".
+	template<
+		typename To,
+		typename From
+	>
+	struct reduction_executor
+	{
+		typedef typename type_traits<To>::std_str_converter std_str_converter;
+		typedef To return_type;
+		typedef typename type_traits<From>::tagged_type tagged_type;
+		typedef ::intelligent_cast_detail::string_converter<tagged_type, typename std_str_converter::handle_type> string_converter;
+		static return_type cast(const From& from)
+		{
+			static_assert(string_converter::is_convertible,"string conversion is not supported. check To and From type.");
+
+			return std_str_converter::reduction( string_converter::to_string( from ) );
+		}
+	};
+
+	// "To" and "From" type are different type and "From" instance is cast to the string type of "To" .
+	template<
+		typename To,
+		typename From,
+		typename TypeInfoTo,
+		typename TypeInfoFrom
+
+	>
+	struct cast_executor : reduction_executor<To, From>
+	{
+	};
+
+	// "To" is numeric type and "From" is string type("From" instance is parsed through its characters without copying)
+	template<
+		typename To,
+		typename From
+	>
+	struct cast_executor<To, From, numeric_type, string_type>
+	{
+		typedef typename type_traits<From>::std_str_converter std_str_converter;
+		typedef typename type_traits<To>::tagged_type tagged_type;
+		typedef ::intelligent_cast_detail::string_converter<tagged_type, typename std_str_converter::handle_type> string_converter;
+		typedef typename string_converter::value_type return_type;
+		static return_type cast(const From& from)
+		{
+			const typename std_str_converter::range_type range = std_str_converter::range( from );
+			return string_converter::get_value( range.first, range.second );
+		}
+	};
+
+	// "To" is inline_string and "From" is numeric type(the text is written in place without std::string)
+	template<
+		size_t N,
+		typename CharT,
+		typename From
+	>
+	struct cast_executor<inline_string<N, CharT>, From, string_type, numeric_type>
+	{
+		typedef inline_string<N, CharT> return_type;
+		static return_type cast(const From& from)
+		{
+			return return_type(from);
+		}
+	};
+
+	// "To" is inline_string and "From" is string type of the same character type(the characters are copied in place without std::string)
+	template<
+		typename To,
+		typename From
+	>
+	struct inline_string_range_executor
+	{
+		typedef typename type_traits<From>::std_str_converter std_str_converter;
+		typedef To return_type;
+		static return_type cast(const From& from)
+		{
+			const typename std_str_converter::range_type range = std_str_converter::range( from );
+			return return_type(range.first, range.second);
+		}
+	};
+
+	template<
+		size_t N,
+		typename CharT,
+		typename From
+	>
+	struct cast_executor<inline_string<N, CharT>, From, string_type, string_type>
+		: std::conditional<
+			std::is_same<typename type_traits<From>::std_str_converter::range_type::first_type, const CharT*>::value,
+			inline_string_range_executor<inline_string<N, CharT>, From>,
+			reduction_executor<inline_string<N, CharT>, From>
+		>::type
+	{
+	};
+
+	// "To" and "From" are same inline_string(this resolves the ambiguity between the specialization above and the same type)
+	template<
+		size_t N,
+		typename CharT
+	>
+	struct cast_executor<inline_string<N, CharT>, inline_string<N, CharT>, string_type, string_type>
+	{
+		typedef const inline_string<N, CharT>& return_type;
+		static return_type cast(return_type from)
+		{
+			return from;
+		}
+	};
+
+	// "To" and "From" are differens type and neither type is string type. 
+	template<
+		typename To,
+		typename From
+	>
+	struct cast_executor<To, From, numeric_type, numeric_type>
+	{
+		typedef To return_type;
+		static return_type cast(const From& from)
+		{
+			return static_cast<To>(from);
+		}
+	};
+
+	// "To" and "From" are same type, so never converted.
+	template<
+		typename To,
+		typename TypeInfoTo,
+		typename TypeInfoFrom
+	>
+	struct cast_executor<To, To, TypeInfoTo, TypeInfoFrom>
+	{
+		typedef const To& return_type;
+		static return_type cast(const To& from)
+		{
+			return from;
+		}
+	};
+
+	// "To" and "From" are same numeric type(this resolves the ambiguity between the two specializations above)
+	template<
+		typename To
+	>
+	struct cast_executor<To, To, numeric_type, numeric_type>
+	{
+		typedef const To& return_type;
+		static return_type cast(const To& from)
+		{
+			return from;
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief writer of numeric value or string into existing string or buffer
+	 *
+	 *	append appends text of From instance to string, and write writes it to [first, last) and returns the end.
+	 *	write returns NULL if the text does not fit.\n
+	 *	length_bound provides an upper bound of the number of characters of CharT which are written.
+	 */
+	//---------------------------------------------------------------------------
+	template<
+		typename From,
+		typename TypeInfoFrom = typename type_traits<From>::type_info
+	>
+	struct append_executor
+	{
+		static_assert(std::is_arithmetic<From>::value, "string conversion is not supported. check From type.");
+
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const From& from)
+		{
+			numeric_backend<From, typename StdStrType::value_type>::append(dst, from);
+		}
+		template<typename CharT>
+		static CharT* write(CharT* first, CharT* last, const From& from)
+		{
+			return numeric_backend<From, CharT>::write(first, last, from);
+		}
+		template<typename CharT>
+		static size_t length_bound(const From& from)
+		{
+			return format_length_bound(from);
+		}
+	};
+
+	// "From" is string type, its characters are copied or transcoded
+	template<typename From>
+	struct append_executor<From, string_type>
+	{
+		typedef typename type_traits<From>::std_str_converter std_str_converter;
+
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const From& from)
+		{
+			const typename std_str_converter::range_type range = std_str_converter::range(from);
+			append_range(dst, range.first, range.second);
+		}
+		template<typename CharT>
+		static CharT* write(CharT* first, CharT* last, const From& from)
+		{
+			const typename std_str_converter::range_type range = std_str_converter::range(from);
+			return write_range(first, last, range.first, range.second);
+		}
+		template<typename CharT>
+		static size_t length_bound(const From& from)
+		{
+			const typename std_str_converter::range_type range = std_str_converter::range(from);
+			return range_length_bound<CharT>(range.first, range.second);
+		}
+	};
+
+	/** check whether T is std::basic_string of any traits and allocator */
 	template<typename T>
-	struct type_traits
+	struct is_basic_string : std::false_type
+	{
+	};
+	template<typename CharT, typename Traits, typename Alloc>
+	struct is_basic_string<std::basic_string<CharT, Traits, Alloc> > : std::true_type
 	{
-		typedef T original_type, tagged_type;
-		typedef numeric_type type_info;
 	};
 
-	template<>
-	struct type_traits<const char*>
+	/** check whether the text of From is written by append_executor (numeric value or string type) */
+	template<typename From>
+	struct is_appendable : std::integral_constant<bool,
+		std::is_arithmetic<From>::value || std::is_same<typename type_traits<From>::type_info, string_type>::value>
 	{
-		typedef const char* original_type;
-		typedef original_type tagged_type;
-		typedef string_type type_info;
-		typedef string_converter<tagged_type, std::string> std_str_converter;
 	};
 
-	template<>
-	struct type_traits<const wchar_t*>
+	// "To" is std::basic_string, the text is appended to the result built with the allocator(no intermediate string is built).
+	template<
+		typename To,
+		typename From
+	>
+	struct allocator_string_executor
 	{
-		typedef const wchar_t* original_type;
-		typedef original_type tagged_type;
-		typedef string_type type_info;
-		typedef string_converter<tagged_type, std::wstring> std_str_converter;
+		typedef To return_type;
+		static return_type cast(const From& from, const typename To::allocator_type& allocator = typename To::allocator_type())
+		{
+			return_type result(allocator);
+			append_executor<From>::append(result, from);
+			return result;
+		}
 	};
 
-	template<size_t t>
-	struct type_traits<const char[t]>
+	// "To" is std::basic_string, "From" of user defined converter is reduced through std::string or std::wstring
+	template<
+		typename CharT,
+		typename Traits,
+		typename Alloc,
+		typename From,
+		typename TypeInfoFrom
+	>
+	struct cast_executor<std::basic_string<CharT, Traits, Alloc>, From, string_type, TypeInfoFrom>
+		: std::conditional<
+			is_appendable<From>::value,
+			allocator_string_executor<std::basic_string<CharT, Traits, Alloc>, From>,
+			reduction_executor<std::basic_string<CharT, Traits, Alloc>, From>
+		>::type
 	{
-		typedef const char* original_type;
-		typedef original_type tagged_type;
-		typedef string_type type_info;
-		typedef string_converter<tagged_type, std::string> std_str_converter;
 	};
 
-	template<size_t t>
-	struct type_traits<const wchar_t[t]>
+	// "To" and "From" are same std::basic_string(this resolves the ambiguity between the specialization above and below)
+	template<
+		typename CharT,
+		typename Traits,
+		typename Alloc
+	>
+	struct cast_executor<std::basic_string<CharT, Traits, Alloc>, std::basic_string<CharT, Traits, Alloc>, string_type, string_type>
 	{
-		typedef const wchar_t* original_type;
-		typedef original_type tagged_type;
-		typedef string_type type_info;
-		typedef string_converter<tagged_type, std::wstring> std_str_converter;
+		typedef const std::basic_string<CharT, Traits, Alloc>& return_type;
+		static return_type cast(return_type from)
+		{
+			return from;
+		}
 	};
 
-	template<>
-	struct type_traits<std::string>
+#ifdef _AFX
+	// "To" is CString, the text is written into the buffer of the result(no intermediate string is built).
+	template<
+		typename To,
+		typename From
+	>
+	struct cstring_executor
 	{
-		typedef std::string original_type, tagged_type;
-		typedef string_type type_info;
-		typedef string_converter<tagged_type, tagged_type> std_str_converter;
+		typedef To return_type;
+		typedef typename To::XCHAR char_type;
+		static return_type cast(const From& from)
+		{
+			return_type result;
+			const size_t bound = append_executor<From>::template length_bound<char_type>(from);
+			if(bound != 0)
+			{
+				char_type* const first = result.GetBuffer(static_cast<int>(bound));
+				char_type* const last = append_executor<From>::write(first, first + bound, from);
+				result.ReleaseBuffer(static_cast<int>(last - first));
+			}
+			return result;
+		}
 	};
 
-	template<>
-	struct type_traits<std::wstring>
+	template<
+		typename From,
+		typename TypeInfoFrom
+	>
+	struct cast_executor<CStringA, From, string_type, TypeInfoFrom>
+		: std::conditional<is_appendable<From>::value, cstring_executor<CStringA, From>, reduction_executor<CStringA, From> >::type
 	{
-		typedef std::wstring original_type, tagged_type;
-		typedef string_type type_info;
-		typedef string_converter<tagged_type, tagged_type> std_str_converter;
 	};
 
-#ifdef _AFX
+	template<
+		typename From,
+		typename TypeInfoFrom
+	>
+	struct cast_executor<CStringW, From, string_type, TypeInfoFrom>
+		: std::conditional<is_appendable<From>::value, cstring_executor<CStringW, From>, reduction_executor<CStringW, From> >::type
+	{
+	};
 
+	// "To" and "From" are same CString(this resolves the ambiguity between the specializations above and the same type)
 	template<>
-	struct type_traits<CStringA>
+	struct cast_executor<CStringA, CStringA, string_type, string_type>
 	{
-		typedef CStringA original_type, tagged_type;
-		typedef string_type type_info;
-		typedef string_converter<tagged_type, std::string> std_str_converter;
+		typedef const CStringA& return_type;
+		static return_type cast(return_type from)
+		{
+			return from;
+		}
 	};
 
 	template<>
-	struct type_traits<CStringW>
+	struct cast_executor<CStringW, CStringW, string_type, string_type>
 	{
-		typedef CStringW original_type, tagged_type;
-		typedef string_type type_info;
-		typedef string_converter<tagged_type, std::wstring> std_str_converter;
+		typedef const CStringW& return_type;
+		static return_type cast(return_type from)
+		{
+			return from;
+		}
 	};
-
 #endif
 
-	// "To" and "From" type are different type and "From" instance is cast to the string type of "To" .
-	template<
-		typename To,
-		typename From,
-		typename TypeInfoTo,
-		typename TypeInfoFrom
-
-	>
-	struct cast_executor
+#if defined(INTELLIGENT_CAST_ENABLE_STATISTICS)
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief executor which reports the outcome of cast_executor to statistics
+	 *
+	 *	bytes is the size of characters of the result when "To" is string type,
+	 *	and failed is set when "From" string is not parsed as ok by try_intelligent_cast.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename To, typename From, typename TypeinfoTo, typename TypeinfoFrom, typename CasterType>
+	struct statistics_executor
 	{
-		typedef typename type_traits<To>::std_str_converter std_str_converter;
-		typedef To return_type;
-		typedef typename type_traits<From>::tagged_type tagged_type;
-		typedef typename string_converter<tagged_type, typename std_str_converter::handle_type> string_converter;
-		static return_type cast(const From& from)
+		static const char* name() { return std::is_same<TypeinfoFrom, string_type>::value ? "numeric<-string" : "numeric<-numeric"; }
+		static typename CasterType::return_type cast(const From& from, bool& /*failed*/, size_t& /*bytes*/)
 		{
-			static_assert(string_converter::is_convertible,"string conversion is not supported. check To and From type.");
-
-			return std_str_converter::reduction( string_converter::to_string( from ) );
+			return CasterType::cast(from);
 		}
 	};
 
-	// "To" is numeric type and "From" is string type("From" instance is casted to string type)
-	template<
-		typename To,
-		typename From
-	>
-	struct cast_executor<To, From, numeric_type, string_type>
+	template<typename To, typename From, typename TypeinfoFrom, typename CasterType>
+	struct statistics_executor<To, From, string_type, TypeinfoFrom, CasterType>
 	{
-		typedef typename type_traits<From>::std_str_converter std_str_converter;
-		typedef typename type_traits<To>::tagged_type tagged_type;
-		typedef typename string_converter<tagged_type, typename std_str_converter::handle_type> string_converter;
-		typedef typename string_converter::value_type return_type;
-		static return_type cast(const From& from)
+		static const char* name() { return std::is_same<TypeinfoFrom, string_type>::value ? "string<-string" : "string<-numeric"; }
+		static typename CasterType::return_type cast(const From& from, bool& /*failed*/, size_t& bytes)
 		{
-			return string_converter::get_value( std_str_converter::to_string( from ) );
+			typename CasterType::return_type result = CasterType::cast(from);
+			const typename type_traits<To>::std_str_converter::range_type range = type_traits<To>::std_str_converter::range(result);
+			bytes = static_cast<size_t>(range.second - range.first) * sizeof(*range.first);
+			return result;
 		}
 	};
 
-	// "To" and "From" are differens type and neither type is string type. 
-	template<
-		typename To,
-		typename From
-	>
-	struct cast_executor<To, From, numeric_type, numeric_type>
+	// the string is parsed here instead of cast_executor to know whether it is parsed as ok, the value is the same
+	template<typename To, typename From>
+	struct statistics_executor<To, From, numeric_type, string_type, cast_executor<To, From, numeric_type, string_type> >
 	{
-		typedef typename To return_type;
-		static return_type cast(const From& from)
+		typedef typename type_traits<From>::std_str_converter std_str_converter;
+		typedef ::intelligent_cast_detail::string_converter<typename type_traits<To>::tagged_type, typename std_str_converter::handle_type> string_converter;
+
+		static const char* name() { return "numeric<-string"; }
+		static typename string_converter::value_type cast(const From& from, bool& failed, size_t& /*bytes*/)
 		{
-			return static_cast<To>(from);
+			const typename std_str_converter::range_type range = std_str_converter::range(from);
+			typename string_converter::value_type value;
+			bool out_of_range;
+			const typename std_str_converter::range_type::first_type end = string_converter::parse(range.first, range.second, value, out_of_range);
+			failed = end == range.first || out_of_range || end != range.second;
+			return value;
 		}
 	};
 
-	// "To" and "From" are same type, so never converted.
+#define INTELLIGENT_CAST_STATISTICS_TYPE_NAME(type, name) \
+	template<> struct statistics_type_name<type> { static const char* get() { return #type; } };
+
+	INTELLIGENT_CAST_NUMERIC_TYPES(INTELLIGENT_CAST_STATISTICS_TYPE_NAME)
+	INTELLIGENT_CAST_STATISTICS_TYPE_NAME(std::string, string_)
+	INTELLIGENT_CAST_STATISTICS_TYPE_NAME(std::wstring, wstring_)
+
+#undef INTELLIGENT_CAST_STATISTICS_TYPE_NAME
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief counters of the calling thread for the type pair
+	 */
+	//---------------------------------------------------------------------------
+	template<typename To, typename From, typename Executor>
+	inline statistics_counters& thread_statistics()
+	{
+		static statistics_pair pair(statistics_type_name<To>::get(), statistics_type_name<From>::get(), Executor::name());
+		static thread_local const statistics_thread_counters counters(pair);
+		return counters.get();
+	}
+
+	// counts calls, failed parses and produced bytes, and times sampled calls
 	template<
-		typename To,
-		typename TypeInfoTo,
-		typename TypeInfoFrom
+		typename To, 
+		typename From,
+		typename TypeinfoTo =  typename type_traits<To>::type_info,
+		typename TypeinfoFrom =  typename type_traits<From>::type_info,
+		typename CasterType = cast_executor<To, From, TypeinfoTo, TypeinfoFrom>,
+		typename ReturnType = typename CasterType::return_type
 	>
-	struct cast_executor<To, To, TypeInfoTo, TypeInfoFrom>
+	struct intelligent_cast_helper
 	{
-		typedef typename const To& return_type;
-		static return_type cast(const To& from)
+		typedef ReturnType return_type;
+		typedef statistics_executor<To, From, TypeinfoTo, TypeinfoFrom, CasterType> executor;
+		static return_type cast(const From& from)
 		{
-			return from;
+			statistics_counters& counters = thread_statistics<To, From, executor>();
+			bool failed = false;
+			size_t bytes = 0;
+			if(!counters.sample())
+			{
+				return_type result = executor::cast(from, failed, bytes);
+				counters.record(failed, bytes);
+				return result;
+			}
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			return_type result = executor::cast(from, failed, bytes);
+			counters.record_latency(std::chrono::steady_clock::now() - start);
+			counters.record(failed, bytes);
+			return result;
 		}
 	};
-
+#else
 	template<
 		typename To, 
 		typename From,
@@ -534,6 +3601,7 @@ NUMERIC_STRING_CONVERTER(float, float_,
 			return CasterType::cast(from);
 		}
 	};
+#endif
 
 } // End Of Namespace intelligent_cast_detail 
 
@@ -554,3 +3622,228 @@ intelligent_cast(const From& from)
 	return intelligent_cast_helper<To, From>::cast(from);
 }
 
+//---------------------------------------------------------------------------
+/*!
+ * @brief   intelligent cast to string built with allocator
+ * @param[in] from numeric value or string of any type which intelligent_cast accepts
+ * @param[in] allocator allocator of the result (std::pmr::memory_resource* is accepted for std::pmr::string)
+ * @returns std::basic_string of To type
+ *
+ * the text is written into the result directly, so all memory of the conversion is obtained from the allocator.
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename From>
+typename std::enable_if<intelligent_cast_detail::is_basic_string<To>::value, To>::type
+intelligent_cast(const From& from, const typename To::allocator_type& allocator)
+{
+	return intelligent_cast_detail::allocator_string_executor<To, From>::cast(from, allocator);
+}
+
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   intelligent cast from character range
+ * @param[in] first first character
+ * @param[in] last one past the last character
+ * @returns numeric value parsed from [first, last)
+ *
+ * the range is parsed in place, it need not be terminated by NUL.
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename CharT>
+typename std::enable_if<
+	std::is_same<typename intelligent_cast_detail::type_traits<To>::type_info, intelligent_cast_detail::numeric_type>::value, To
+>::type
+intelligent_cast(const CharT* first, const CharT* last)
+{
+	using namespace intelligent_cast_detail;
+	return string_converter<To, std::basic_string<CharT> >::get_value(first, last);
+}
+
+//---------------------------------------------------------------------------
+/**
+ * @brief error of try_intelligent_cast and intelligent_cast_to
+ */
+//---------------------------------------------------------------------------
+enum class intelligent_cast_errc
+{
+	ok,						///< whole input is parsed
+	invalid_argument,		///< no number is found
+	out_of_range,			///< number is not representable in the result type
+	trailing_characters,	///< number is followed by characters which are not parsed
+	buffer_too_small		///< converted text does not fit in the buffer
+};
+
+//---------------------------------------------------------------------------
+/**
+ * @brief result of try_intelligent_cast
+ * @param T numeric value type
+ *
+ *	value is 0 for invalid_argument, the saturated value for out_of_range,
+ *	and the parsed value for trailing_characters.
+ */
+//---------------------------------------------------------------------------
+template<typename T>
+struct intelligent_cast_result
+{
+	T value;
+	intelligent_cast_errc error;
+	size_t consumed;		///< number of characters parsed, including leading white spaces and sign
+	explicit operator bool() const { return error == intelligent_cast_errc::ok; }
+};
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   intelligent cast from character range which reports error
+ * @param[in] first first character
+ * @param[in] last one past the last character
+ * @returns parsed value, error and the number of characters parsed
+ *
+ * range is checked in the same pass as the digits are accumulated, neither exception nor errno is used.
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename CharT>
+typename std::enable_if<
+	std::is_same<typename intelligent_cast_detail::type_traits<To>::type_info, intelligent_cast_detail::numeric_type>::value,
+	intelligent_cast_result<To>
+>::type
+try_intelligent_cast(const CharT* first, const CharT* last)
+{
+	using namespace intelligent_cast_detail;
+	intelligent_cast_result<To> result;
+	bool out_of_range;
+	const CharT* const end = string_converter<To, std::basic_string<CharT> >::parse(first, last, result.value, out_of_range);
+	result.consumed = static_cast<size_t>(end - first);
+	result.error =
+		end == first ? intelligent_cast_errc::invalid_argument :
+		out_of_range ? intelligent_cast_errc::out_of_range :
+		end != last ? intelligent_cast_errc::trailing_characters : intelligent_cast_errc::ok;
+	return result;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   intelligent cast from string which reports error
+ * @param[in] from string of any type which intelligent_cast accepts
+ * @returns parsed value, error and the number of characters parsed
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename From>
+typename std::enable_if<
+	std::is_same<typename intelligent_cast_detail::type_traits<To>::type_info, intelligent_cast_detail::numeric_type>::value,
+	intelligent_cast_result<To>
+>::type
+try_intelligent_cast(const From& from)
+{
+	using namespace intelligent_cast_detail;
+	const typename type_traits<From>::std_str_converter::range_type range = type_traits<From>::std_str_converter::range(from);
+	return try_intelligent_cast<To>(range.first, range.second);
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   append converted text to string
+ * @param[in,out] dst std::basic_string of char or wchar_t with any allocator, which is appended to
+ * @param[in] from numeric value or string of any type which intelligent_cast accepts
+ * @returns dst
+ *
+ * the text is written into the existing capacity of dst, no temporary string is built for numeric value.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT, typename From, typename Traits, typename Alloc>
+std::basic_string<CharT, Traits, Alloc>& intelligent_cast_append(std::basic_string<CharT, Traits, Alloc>& dst, const From& from)
+{
+	using namespace intelligent_cast_detail;
+	append_executor<From>::append(dst, from);
+	return dst;
+}
+
+namespace intelligent_cast_detail
+{
+	/** upper bound of the number of characters of all operands */
+	template<typename CharT>
+	inline size_t concat_length_bound()
+	{
+		return 0;
+	}
+	template<typename CharT, typename T, typename... Rest>
+	inline size_t concat_length_bound(const T& operand, const Rest&... rest)
+	{
+		return append_executor<T>::template length_bound<CharT>(operand) + concat_length_bound<CharT>(rest...);
+	}
+
+	/** append text of all operands in order */
+	template<typename StdStrType>
+	inline void concat_append(StdStrType&)
+	{
+	}
+	template<typename StdStrType, typename T, typename... Rest>
+	inline void concat_append(StdStrType& dst, const T& operand, const Rest&... rest)
+	{
+		append_executor<T>::append(dst, operand);
+		concat_append(dst, rest...);
+	}
+}	// End of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   concatenate string and converted text of values
+ * @param[in] str std::basic_string of char or wchar_t with any allocator, which is the head of the result
+ * @param[in] operands numeric values or strings of any type which intelligent_cast accepts
+ * @returns new string of the same type as str
+ *
+ * the length of every operand is bounded first, then the result is built with one allocation and one write per operand.\n
+ * intelligent_cast_concat(str, 10, " and ", 5.5) is the same text as str + 10 + " and " + 5.5 of OperatorOverloadExtension.h.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT, typename Traits, typename Alloc, typename... Types>
+std::basic_string<CharT, Traits, Alloc> intelligent_cast_concat(const std::basic_string<CharT, Traits, Alloc>& str, const Types&... operands)
+{
+	using namespace intelligent_cast_detail;
+	std::basic_string<CharT, Traits, Alloc> result(str.get_allocator());
+	result.reserve(str.size() + concat_length_bound<CharT>(operands...));
+	result.append(str);
+	concat_append(result, operands...);
+	return result;
+}
+
+//---------------------------------------------------------------------------
+/**
+ * @brief result of intelligent_cast_to
+ * @param CharT character type of buffer
+ *
+ *	ptr is one past the last character written, or last of the buffer when error is buffer_too_small.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT>
+struct intelligent_cast_to_result
+{
+	CharT* ptr;
+	intelligent_cast_errc error;
+	explicit operator bool() const { return error == intelligent_cast_errc::ok; }
+};
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   write converted text to buffer
+ * @param[in] first first character of buffer
+ * @param[in] last one past the last character of buffer
+ * @param[in] from numeric value or string of any type which intelligent_cast accepts
+ * @returns the end of written text, or buffer_too_small error
+ *
+ * the text is not terminated by NUL. the contents of buffer are unspecified when the text does not fit.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT, typename From>
+intelligent_cast_to_result<CharT> intelligent_cast_to(CharT* first, CharT* last, const From& from)
+{
+	using namespace intelligent_cast_detail;
+	intelligent_cast_to_result<CharT> result;
+	result.ptr = append_executor<From>::write(first, last, from);
+	result.error = result.ptr ? intelligent_cast_errc::ok : intelligent_cast_errc::buffer_too_small;
+	if(!result.ptr)
+	{
+		result.ptr = last;
+	}
+	return result;
+}
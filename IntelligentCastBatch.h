@@ -0,0 +1,355 @@
+#pragma once
+#include <string>
+#include "IntelligentCast.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define INTELLIGENT_CAST_BATCH_X86
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(INTELLIGENT_CAST_BATCH_X86) && defined(__GNUC__)
+#define INTELLIGENT_CAST_TARGET(isa) __attribute__((target(isa)))
+#else
+#define INTELLIGENT_CAST_TARGET(isa)
+#endif
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief instruction sets available at runtime
+	 *
+	 *	detected once on first use, the batch functions choose their kernel from this.
+	 */
+	//---------------------------------------------------------------------------
+	struct cpu_features
+	{
+		bool sse2;
+		bool sse41;
+
+		static const cpu_features& get()
+		{
+			static const cpu_features features = detect();
+			return features;
+		}
+	private:
+		static cpu_features detect()
+		{
+			cpu_features features = { false, false };
+#if defined(INTELLIGENT_CAST_BATCH_X86)
+			unsigned int ecx = 0, edx = 0;
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 1);
+			ecx = static_cast<unsigned int>(info[2]);
+			edx = static_cast<unsigned int>(info[3]);
+#else
+			unsigned int eax, ebx;
+			if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			{
+				return features;
+			}
+#endif
+			features.sse2 = (edx & (1u << 26)) != 0;
+			// SSE4.1 kernel also uses SSSE3 instructions
+			features.sse41 = (ecx & (1u << 9)) != 0 && (ecx & (1u << 19)) != 0;
+#endif
+			return features;
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief scalar kernel of batch conversion
+	 *
+	 *	write writes text of value from out without bounds checking,
+	 *	parse parses one field and returns whether the whole field is a valid number.
+	 */
+	//---------------------------------------------------------------------------
+	struct scalar_kernel
+	{
+		template<typename CharT, typename T>
+		static typename std::enable_if<std::is_integral<T>::value, CharT*>::type
+		write(CharT* out, const T& value)
+		{
+			const integral_magnitude<T> digits(value);
+			digits.write(out);
+			return out + digits.length;
+		}
+		template<typename CharT, typename T>
+		static typename std::enable_if<std::is_floating_point<T>::value, CharT*>::type
+		write(CharT* out, const T& value)
+		{
+			return write_floating(out, value);
+		}
+		template<typename T, typename CharT>
+		static bool parse(const CharT* first, const CharT* last, const CharT* /*text_last*/, T& value)
+		{
+			bool out_of_range;
+			const CharT* const end = string_converter<T, std::basic_string<CharT> >::parse(first, last, value, out_of_range);
+			return end != first && end == last && !out_of_range;
+		}
+	};
+
+#if defined(INTELLIGENT_CAST_BATCH_X86)
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief decimal digits of value less than 10^8 in eight 16-bit lanes, most significant first
+	 *
+	 *	the value is split into two 4 digit halves, and each half is divided by 10^3, 10^2, 10^1 and 10^0 in parallel
+	 *	with multiply-high by reciprocals.
+	 */
+	//---------------------------------------------------------------------------
+	INTELLIGENT_CAST_TARGET("sse2")
+	inline __m128i digits8_sse2(unsigned int value)
+	{
+		// abcd = abcdefgh / 10000, efgh = abcdefgh % 10000
+		const __m128i abcdefgh = _mm_cvtsi32_si128(static_cast<int>(value));
+		const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(abcdefgh, _mm_set1_epi32(static_cast<int>(0xD1B71759u))), 45);
+		const __m128i efgh = _mm_sub_epi32(abcdefgh, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+
+		// [abcd * 4] x 4, [efgh * 4] x 4
+		const __m128i v1 = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+		const __m128i v2 = _mm_unpacklo_epi32(_mm_unpacklo_epi16(v1, v1), _mm_unpacklo_epi16(v1, v1));
+
+		// [a, ab, abc, abcd, e, ef, efg, efgh]
+		const __m128i div_powers = _mm_setr_epi16(8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768);
+		const __m128i shift_powers = _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768);
+		const __m128i v4 = _mm_mulhi_epu16(_mm_mulhi_epu16(v2, div_powers), shift_powers);
+
+		// [a, b, c, d, e, f, g, h]
+		const __m128i v6 = _mm_slli_epi64(_mm_mullo_epi16(v4, _mm_set1_epi16(10)), 16);
+		return _mm_sub_epi16(v4, v6);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief SSE kernel of batch conversion
+	 *
+	 *	integral values are written 16 digits at a time by SSE2 digit generation,
+	 *	and fields of up to 16 digits are parsed with SSSE3 and SSE4.1 multiply-add reduction.
+	 *	other cases are passed to scalar_kernel.
+	 */
+	//---------------------------------------------------------------------------
+	struct sse_kernel
+	{
+		template<typename CharT, typename T>
+		static CharT* write(CharT* out, const T& value)
+		{
+			return scalar_kernel::write(out, value);
+		}
+		template<typename T>
+		static typename std::enable_if<std::is_integral<T>::value, char*>::type
+		write(char* out, const T& value)
+		{
+			const integral_magnitude<T> digits(value);
+			if(digits.magnitude < 10000u)
+			{
+				digits.write(out);
+				return out + digits.length;
+			}
+			*out = '-';
+			char* last = out + digits.length;
+			unsigned long long magnitude = digits.magnitude;
+			if(magnitude >= 10000000000000000ULL)
+			{
+				// at most 4 digits remain above 16 digits
+				write_digits(last - 16, magnitude / 10000000000000000ULL);
+				magnitude %= 10000000000000000ULL;
+				write16(last - 16, magnitude, 16);
+			}
+			else
+			{
+				write16(last - (digits.length - (digits.negative ? 1 : 0)), magnitude, digits.length - (digits.negative ? 1 : 0));
+			}
+			return last;
+		}
+		template<typename T, typename CharT>
+		static bool parse(const CharT* first, const CharT* last, const CharT* text_last, T& value)
+		{
+			return scalar_kernel::parse(first, last, text_last, value);
+		}
+		template<typename T>
+		static typename std::enable_if<std::is_integral<T>::value, bool>::type
+		parse(const char* first, const char* last, const char* text_last, T& value)
+		{
+			const char* p = first;
+			while(p != last && is_space(*p))
+			{
+				++p;
+			}
+			bool negative = false;
+			if(p != last && (*p == '-' || *p == '+'))
+			{
+				negative = *p == '-';
+				++p;
+			}
+			// 16 bytes must be readable from the first digit
+			if(text_last - p < 16 || last - p > 16 || p == last)
+			{
+				return scalar_kernel::parse(first, last, text_last, value);
+			}
+			int length;
+			const unsigned long long magnitude = parse16(p, static_cast<int>(last - p), length);
+			if(p + length != last)
+			{
+				return scalar_kernel::parse(first, last, text_last, value);
+			}
+
+			typedef typename std::make_unsigned<T>::type unsigned_type;
+			const unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<T>::max()) +
+				(std::numeric_limits<T>::is_signed && negative ? 1u : 0u);
+			if(magnitude > limit)
+			{
+				value = negative && std::numeric_limits<T>::is_signed ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+				return false;
+			}
+			value = static_cast<T>(static_cast<unsigned_type>(negative ? 0u - magnitude : magnitude));
+			return std::numeric_limits<T>::is_signed || !negative || magnitude == 0;
+		}
+	private:
+		/** write the lowest digits of value (less than 10^16) to [out, out + digits) */
+		INTELLIGENT_CAST_TARGET("sse2")
+		static void write16(char* out, unsigned long long value, int digits)
+		{
+			const unsigned int high = static_cast<unsigned int>(value / 100000000u);
+			const unsigned int low = static_cast<unsigned int>(value % 100000000u);
+			const __m128i packed = _mm_packus_epi16(digits8_sse2(high), digits8_sse2(low));
+			char buf[16];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(buf), _mm_add_epi8(packed, _mm_set1_epi8('0')));
+			std::memcpy(out, buf + 16 - digits, digits);
+		}
+		/**
+		 * parse leading digits of [p, p + max_length) where 16 bytes from p are readable.
+		 * length is set to the number of digits, which is at most max_length.
+		 */
+		INTELLIGENT_CAST_TARGET("sse4.1")
+		static unsigned long long parse16(const char* p, int max_length, int& length)
+		{
+			// shuffle control which moves the leading n bytes to the end and clears the others
+			static const signed char shift_table[32] =
+			{
+				-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+				0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+			};
+			const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+			const __m128i is_digit = _mm_cmpeq_epi8(_mm_subs_epu8(digits, _mm_set1_epi8(9)), _mm_setzero_si128());
+			// bit 16 stops the scan when all 16 bytes are digits
+			const unsigned int non_digits = ~static_cast<unsigned int>(_mm_movemask_epi8(is_digit)) | 0x10000u;
+			int n = count_trailing_zeros(non_digits);
+			if(n > max_length)
+			{
+				n = max_length;
+			}
+			length = n;
+
+			const __m128i aligned = _mm_shuffle_epi8(digits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(shift_table + n)));
+			// 2 digits in 16 bits, 4 digits in 32 bits, then 8 digits in 32 bits
+			const __m128i pairs = _mm_maddubs_epi16(aligned, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+			const __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+			const __m128i packed = _mm_packus_epi32(quads, quads);
+			const __m128i octets = _mm_madd_epi16(packed, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+			const unsigned long long high = static_cast<unsigned int>(_mm_cvtsi128_si32(octets));
+			const unsigned long long low = static_cast<unsigned int>(_mm_cvtsi128_si32(_mm_srli_si128(octets, 4)));
+			return high * 100000000u + low;
+		}
+	};
+#endif
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief batch conversion loops, instantiated for each kernel
+	 */
+	//---------------------------------------------------------------------------
+	template<typename Kernel>
+	struct batch_executor
+	{
+		template<typename CharT, typename T>
+		static void format(const T* values, size_t count, std::basic_string<CharT>& text, size_t* offsets)
+		{
+			const size_t base = text.size();
+			text.resize(base + count * max_format_length<T>::value);
+			CharT* const begin = &text[0];
+			CharT* out = begin + base;
+			for(size_t i = 0; i < count; ++i)
+			{
+				offsets[i] = static_cast<size_t>(out - begin);
+				out = Kernel::write(out, values[i]);
+			}
+			offsets[count] = static_cast<size_t>(out - begin);
+			text.resize(offsets[count]);
+		}
+		template<typename T, typename CharT>
+		static size_t parse(const CharT* text, const size_t* offsets, size_t count, T* values)
+		{
+			const CharT* const text_last = text + offsets[count];
+			size_t errors = 0;
+			for(size_t i = 0; i < count; ++i)
+			{
+				if(!Kernel::parse(text + offsets[i], text + offsets[i + 1], text_last, values[i]))
+				{
+					++errors;
+				}
+			}
+			return errors;
+		}
+	};
+}	// End Of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   convert array of numeric values to packed text
+ * @param[in] values numeric values
+ * @param[in] count the number of values
+ * @param[in,out] text std::string or std::wstring which the text of each value is appended to, without delimiter
+ * @param[out] offsets count + 1 positions in text, the i-th value is [offsets[i], offsets[i + 1])
+ *
+ * text is reallocated at most once for the whole batch. the kernel is chosen by the instruction sets of the running CPU.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT, typename T>
+void intelligent_cast_format_batch(const T* values, size_t count, std::basic_string<CharT>& text, size_t* offsets)
+{
+	using namespace intelligent_cast_detail;
+	static_assert(std::is_arithmetic<T>::value, "batch conversion is only supported for numeric value.");
+#if defined(INTELLIGENT_CAST_BATCH_X86)
+	if(cpu_features::get().sse2)
+	{
+		batch_executor<sse_kernel>::format(values, count, text, offsets);
+		return;
+	}
+#endif
+	batch_executor<scalar_kernel>::format(values, count, text, offsets);
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   parse packed text fields into array of numeric values
+ * @param[in] text characters of all fields
+ * @param[in] offsets count + 1 positions in text, the i-th field is [offsets[i], offsets[i + 1])
+ * @param[in] count the number of fields
+ * @param[out] values parsed values, with the same value as intelligent_cast for invalid fields
+ * @returns the number of fields which are not entirely a number in range
+ *
+ * each field is parsed with the same syntax as intelligent_cast. the kernel is chosen by the instruction sets of the running CPU.
+ */
+//---------------------------------------------------------------------------
+template<typename T, typename CharT>
+size_t intelligent_cast_parse_batch(const CharT* text, const size_t* offsets, size_t count, T* values)
+{
+	using namespace intelligent_cast_detail;
+	static_assert(std::is_arithmetic<T>::value, "batch conversion is only supported for numeric value.");
+#if defined(INTELLIGENT_CAST_BATCH_X86)
+	if(cpu_features::get().sse41)
+	{
+		return batch_executor<sse_kernel>::parse(text, offsets, count, values);
+	}
+#endif
+	return batch_executor<scalar_kernel>::parse(text, offsets, count, values);
+}
+
+#undef INTELLIGENT_CAST_TARGET
@@ -0,0 +1,303 @@
+#pragma once
+#include <string>
+#include <limits>
+#include <type_traits>
+#include "IntelligentCast.h"
+
+#if !(defined(__cpp_constexpr) && __cpp_constexpr >= 201304L) && !(defined(_MSC_VER) && _MSC_VER >= 1910)
+#error "IntelligentCastConstexpr.h requires C++14 constexpr"
+#endif
+
+//---------------------------------------------------------------------------
+/**
+ * @brief fixed capacity string built in constant expression
+ * @param CharT character type
+ * @param Capacity the maximum number of characters
+ *
+ *	the characters are terminated by NUL.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT, size_t Capacity>
+struct intelligent_cast_fixed_string
+{
+	CharT data[Capacity + 1];
+	size_t length;
+
+	constexpr intelligent_cast_fixed_string()
+		: data()
+		, length(0)
+	{
+	}
+	constexpr const CharT* c_str() const			{ return data; }
+	constexpr size_t size() const					{ return length; }
+	constexpr CharT operator[](size_t index) const	{ return data[index]; }
+	operator std::basic_string<CharT>() const		{ return std::basic_string<CharT>(data, length); }
+};
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief errors of constant conversion
+	 *
+	 *	these are not constexpr, so evaluating one of them in constant expression makes the program ill-formed
+	 *	and the compiler reports the name of the error.
+	 *	when the conversion is evaluated at runtime they return 0 like intelligent_cast,
+	 *	except that a literal which needs runtime parse is parsed by parse_floating.
+	 */
+	//---------------------------------------------------------------------------
+	inline int constant_literal_is_not_a_number()		{ return 0; }
+	inline int constant_literal_is_out_of_range()		{ return 0; }
+	template<typename T, typename CharT>
+	inline T constant_literal_needs_runtime_parse(const CharT* first, const CharT* last)
+	{
+		T value = 0;
+		bool out_of_range = false;
+		parse_floating(first, last, value, out_of_range);
+		return value;
+	}
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief parse integral literal in constant expression
+	 *
+	 *	the literal is parsed by parse_integral like intelligent_cast, and the whole literal must be a number.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename CharT>
+	constexpr T constant_parse_integral(const CharT* first, const CharT* last)
+	{
+		T value = 0;
+		bool out_of_range = false;
+		const CharT* const end = parse_integral(first, last, value, out_of_range);
+		if(end == first || end != last)
+		{
+			return static_cast<T>(constant_literal_is_not_a_number());
+		}
+		if(out_of_range)
+		{
+			return static_cast<T>(constant_literal_is_out_of_range());
+		}
+		return value;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief case insensitive match of ASCII lower case word at the start of [first, last)
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	constexpr bool constant_match(const CharT* first, const CharT* last, const char* word)
+	{
+		for(; *word; ++word, ++first)
+		{
+			if(first == last || (*first | 0x20) != static_cast<CharT>(*word))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief parse floating point literal in constant expression
+	 *
+	 *	the value is computed by the exact fast path of Clinger: a significand and a power of ten which are
+	 *	both exactly representable in T are multiplied or divided once, so the result is correctly rounded.\n
+	 *	other literals (a significand beyond 2^53 for double or 2^24 for float after trailing zeros are removed,
+	 *	or a power of ten beyond 10^22 for double or 10^10 for float) can not be rounded correctly in this way.
+	 *	they are reported as constant_literal_needs_runtime_parse in constant expression, and parsed by parse_floating at runtime.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename CharT>
+	constexpr T constant_parse_floating(const CharT* first, const CharT* last)
+	{
+		const CharT* const literal = first;
+		// the largest exactly representable significand and power of ten
+		const unsigned long long max_significand = 1ULL << std::numeric_limits<T>::digits;
+		const int max_exponent = std::numeric_limits<T>::digits == 24 ? 10 : 22;
+
+		while(first != last && is_space(*first))
+		{
+			++first;
+		}
+		bool negative = false;
+		if(first != last && (*first == static_cast<CharT>('-') || *first == static_cast<CharT>('+')))
+		{
+			negative = *first == static_cast<CharT>('-');
+			++first;
+		}
+		if((last - first == 8 && constant_match(first, last, "infinity")) || (last - first == 3 && constant_match(first, last, "inf")))
+		{
+			return negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+		}
+		if(last - first == 3 && constant_match(first, last, "nan"))
+		{
+			return std::numeric_limits<T>::quiet_NaN();
+		}
+
+		unsigned long long significand = 0;
+		int exponent = 0;
+		int digits = 0;
+		bool inexact = false;
+		bool fraction = false;
+		for(; first != last; ++first)
+		{
+			if(*first == static_cast<CharT>('.') && !fraction)
+			{
+				fraction = true;
+				continue;
+			}
+			if(digit_value(*first) > 9u)
+			{
+				break;
+			}
+			++digits;
+			const unsigned int digit = digit_value(*first);
+			if(significand < 100000000000000000ULL)
+			{
+				significand = significand * 10u + digit;
+				exponent -= fraction ? 1 : 0;
+			}
+			else
+			{
+				// digits beyond 18 are dropped, the value is exact only if they are zero
+				inexact = inexact || digit != 0;
+				exponent += fraction ? 0 : 1;
+			}
+		}
+		if(digits == 0)
+		{
+			return static_cast<T>(constant_literal_is_not_a_number());
+		}
+		if(first != last && (*first == static_cast<CharT>('e') || *first == static_cast<CharT>('E')))
+		{
+			++first;
+			bool negative_exponent = false;
+			if(first != last && (*first == static_cast<CharT>('-') || *first == static_cast<CharT>('+')))
+			{
+				negative_exponent = *first == static_cast<CharT>('-');
+				++first;
+			}
+			if(first == last || digit_value(*first) > 9u)
+			{
+				return static_cast<T>(constant_literal_is_not_a_number());
+			}
+			int explicit_exponent = 0;
+			for(; first != last && digit_value(*first) <= 9u; ++first)
+			{
+				if(explicit_exponent < 100000)
+				{
+					explicit_exponent = explicit_exponent * 10 + static_cast<int>(digit_value(*first));
+				}
+			}
+			exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+		}
+		if(first != last)
+		{
+			return static_cast<T>(constant_literal_is_not_a_number());
+		}
+		if(significand == 0)
+		{
+			return negative ? -static_cast<T>(0) : static_cast<T>(0);
+		}
+		while(significand % 10u == 0)
+		{
+			significand /= 10u;
+			++exponent;
+		}
+		// move zeros of large exponent into significand while it is exact
+		while(exponent > max_exponent && significand * 10u <= max_significand)
+		{
+			significand *= 10u;
+			--exponent;
+		}
+		if(inexact || significand > max_significand || exponent > max_exponent || exponent < -max_exponent)
+		{
+			return constant_literal_needs_runtime_parse<T>(literal, last);
+		}
+		T power = 1;
+		for(int i = 0; i < (exponent < 0 ? -exponent : exponent); ++i)
+		{
+			power *= 10;
+		}
+		const T value = exponent < 0 ? static_cast<T>(significand) / power : static_cast<T>(significand) * power;
+		return negative ? -value : value;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief format integral value in constant expression
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	constexpr intelligent_cast_fixed_string<CharT, std::numeric_limits<T>::digits10 + 2> constant_format_integral(T value)
+	{
+		typedef typename unsigned_digits_type<T>::type digits_type;
+
+		intelligent_cast_fixed_string<CharT, std::numeric_limits<T>::digits10 + 2> result;
+		const bool negative = value < static_cast<T>(0);
+		digits_type magnitude = negative ? static_cast<digits_type>(0u - static_cast<digits_type>(value)) : static_cast<digits_type>(value);
+		// digits are written backward from the end, then moved to the front
+		CharT digits[std::numeric_limits<T>::digits10 + 2] = {};
+		size_t count = 0;
+		do
+		{
+			digits[count++] = static_cast<CharT>('0' + magnitude % 10u);
+			magnitude /= 10u;
+		} while(magnitude != 0);
+		if(negative)
+		{
+			result.data[result.length++] = static_cast<CharT>('-');
+		}
+		while(count != 0)
+		{
+			result.data[result.length++] = digits[--count];
+		}
+		return result;
+	}
+}	// End Of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   intelligent cast from string literal in constant expression
+ * @param[in] literal string literal of char or wchar_t
+ * @returns numeric value
+ *
+ * the syntax is the same as intelligent_cast, but the whole literal must be a number.
+ * when this is evaluated in constant expression (constexpr variable, template argument, static_assert),
+ * a malformed or out of range literal is a compile error.
+ * floating point literals are limited to those which can be rounded exactly at compile time
+ * (a significand up to 2^53 and a power of ten within 10^22 for double), other literals are parsed at runtime.
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename CharT, size_t N>
+constexpr typename std::enable_if<std::is_integral<To>::value, To>::type
+intelligent_cast_constant(const CharT (&literal)[N])
+{
+	return intelligent_cast_detail::constant_parse_integral<To>(literal, literal + (literal[N - 1] ? N : N - 1));
+}
+template<typename To, typename CharT, size_t N>
+constexpr typename std::enable_if<std::is_floating_point<To>::value, To>::type
+intelligent_cast_constant(const CharT (&literal)[N])
+{
+	return intelligent_cast_detail::constant_parse_floating<To>(literal, literal + (literal[N - 1] ? N : N - 1));
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   intelligent cast from integral value to text in constant expression
+ * @param[in] from integral value
+ * @returns intelligent_cast_fixed_string of the character type of To (std::string or std::wstring)
+ *
+ * the text is the same as intelligent_cast<To>(from), and converted to To implicitly.
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename From>
+constexpr typename std::enable_if<
+	std::is_integral<From>::value &&
+	std::is_same<To, std::basic_string<typename To::value_type> >::value,
+	intelligent_cast_fixed_string<typename To::value_type, std::numeric_limits<From>::digits10 + 2>
+>::type
+intelligent_cast_constant(const From& from)
+{
+	return intelligent_cast_detail::constant_format_integral<typename To::value_type>(from);
+}
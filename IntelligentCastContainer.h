@@ -0,0 +1,723 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "IntelligentCast.h"
+
+//---------------------------------------------------------------------------
+// std::vector, std::array, std::pair and std::tuple are converted to and from delimited text.
+// the elements are joined with ',' by default, and another delimiter is given by intelligent_cast_fmt::delimited.
+//---------------------------------------------------------------------------
+
+namespace intelligent_cast_fmt
+{
+	/** base of delimiter policies, which tells intelligent_cast that the second template argument is a delimiter */
+	struct delimiter_policy{};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief elements are joined and split by Delimiter
+	 *
+	 *	intelligent_cast<std::string, intelligent_cast_fmt::delimited<';'> >(values) joins values with ';'.
+	 *	the delimiter is widened to wchar_t for wide strings.
+ *	string element which contains the delimiter or '"' is quoted as in CSV, so that it is split back into one element.
+	 */
+	//---------------------------------------------------------------------------
+	template<char Delimiter>
+	struct delimited : delimiter_policy
+	{
+		static const char value = Delimiter;
+	};
+}	// End Of Namespace intelligent_cast_fmt
+
+namespace intelligent_cast_detail
+{
+	/** a container type tag to be added to type_traits */
+	struct container_type{};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief check whether a type is a delimiter policy
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	struct is_delimiter_policy : std::is_base_of<intelligent_cast_fmt::delimiter_policy, T>
+	{
+	};
+
+	/** delimiter used when no delimiter policy is given */
+	typedef intelligent_cast_fmt::delimited<','> default_delimiter;
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief fields of delimited text, which are read in order without copying
+	 *
+	 *	empty text has no field, otherwise n delimiters separate n + 1 fields.\n
+	 *	a field which starts with '"' and whose closing '"' is followed by the delimiter or the end is quoted as in CSV,
+	 *	the delimiters in it do not separate fields and "" in it is read as one '"'.
+	 *	only a quoted field which contains "" is copied, other fields are read in place.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	class field_reader
+	{
+	public:
+		field_reader(const CharT* first, const CharT* last, CharT delimiter)
+			: next_(first)
+			, last_(last)
+			, delimiter_(delimiter)
+			, done_(first == last)
+		{
+		}
+		/** upper bound of the number of fields which are not read yet (a delimiter in quoted field is counted) */
+		size_t count() const
+		{
+			return done_ ? 0 : static_cast<size_t>(std::count(next_, last_, delimiter_)) + 1;
+		}
+		bool read(const CharT*& first, const CharT*& last)
+		{
+			if(done_)
+			{
+				return false;
+			}
+			const CharT* end;
+			if(!read_quoted(first, last, end))
+			{
+				first = next_;
+				last = end = std::find(next_, last_, delimiter_);
+			}
+			done_ = end == last_;
+			next_ = done_ ? last_ : end + 1;
+			return true;
+		}
+	private:
+		static CharT quote()	{ return static_cast<CharT>('"'); }
+		// [first, last) is the quoted characters, or unescaped_ if they contain "", and end is one past the closing '"'
+		bool read_quoted(const CharT*& first, const CharT*& last, const CharT*& end)
+		{
+			if(next_ == last_ || *next_ != quote())
+			{
+				return false;
+			}
+			bool escaped = false;
+			const CharT* closing = next_ + 1;
+			for(;; closing += 2)
+			{
+				closing = std::find(closing, last_, quote());
+				if(closing == last_ || closing + 1 == last_ || closing[1] != quote())
+				{
+					break;
+				}
+				escaped = true;
+			}
+			if(closing == last_ || (closing + 1 != last_ && closing[1] != delimiter_))
+			{
+				return false;
+			}
+			end = closing + 1;
+			first = next_ + 1;
+			last = closing;
+			if(escaped)
+			{
+				unescaped_.clear();
+				for(; first != last; ++first)
+				{
+					unescaped_.push_back(*first);
+					first += *first == quote() ? 1 : 0;
+				}
+				first = unescaped_.data();
+				last = first + unescaped_.size();
+			}
+			return true;
+		}
+		const CharT* next_;
+		const CharT* last_;
+		CharT delimiter_;
+		bool done_;
+		std::basic_string<CharT> unescaped_;
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief element of container parsed from a field
+	 *
+	 *	numeric value is parsed in place, std::basic_string is built from the characters (transcoded if needed),
+	 *	and other types are converted through std::basic_string of the field.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename TypeInfo = typename type_traits<T>::type_info>
+	struct element_parser
+	{
+		template<typename CharT>
+		static T parse(const CharT* first, const CharT* last)
+		{
+			return string_converter<T, std::basic_string<CharT> >::get_value(first, last);
+		}
+	};
+	template<typename T>
+	struct element_parser<T, string_type>
+	{
+		template<typename CharT>
+		static T parse(const CharT* first, const CharT* last)
+		{
+			return intelligent_cast<T>(std::basic_string<CharT>(first, last));
+		}
+	};
+	template<typename CharT, typename Traits, typename Alloc>
+	struct element_parser<std::basic_string<CharT, Traits, Alloc>, string_type>
+	{
+		template<typename FieldCharT>
+		static std::basic_string<CharT, Traits, Alloc> parse(const FieldCharT* first, const FieldCharT* last)
+		{
+			std::basic_string<CharT, Traits, Alloc> element;
+			append_range(element, first, last);
+			return element;
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief text of element, which is written by append_executor of the element
+	 *
+	 *	string element which contains the delimiter or '"' is quoted as in CSV, and '"' in it is doubled,
+	 *	so that field_reader reads it back as one field.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename TypeInfo = typename type_traits<T>::type_info>
+	struct element_text
+	{
+		template<typename CharT>
+		static size_t length_bound(const T& element, CharT)
+		{
+			return append_executor<T>::template length_bound<CharT>(element);
+		}
+		template<typename CharT>
+		static CharT* write(CharT* first, CharT* last, const T& element, CharT)
+		{
+			return append_executor<T>::write(first, last, element);
+		}
+	};
+	template<typename T>
+	struct element_text<T, string_type>
+	{
+		typedef typename type_traits<T>::std_str_converter std_str_converter;
+		typedef typename std_str_converter::range_type range_type;
+
+		/** the number of '"' in the element plus 2, or 0 if the element is not quoted */
+		template<typename CharT>
+		static size_t quoting_length(const range_type& range, CharT delimiter)
+		{
+			typedef typename std::remove_const<typename std::remove_pointer<typename range_type::first_type>::type>::type source_char;
+			size_t quotes = 0;
+			bool quoted = false;
+			for(typename range_type::first_type p = range.first; p != range.second; ++p)
+			{
+				quotes += *p == static_cast<source_char>('"') ? 1 : 0;
+				quoted = quoted || *p == static_cast<source_char>(delimiter);
+			}
+			return quoted || quotes != 0 ? quotes + 2 : 0;
+		}
+		template<typename CharT>
+		static size_t length_bound(const T& element, CharT delimiter)
+		{
+			const range_type range = std_str_converter::range(element);
+			return range_length_bound<CharT>(range.first, range.second) + quoting_length(range, delimiter);
+		}
+		template<typename CharT>
+		static CharT* write(CharT* first, CharT* last, const T& element, CharT delimiter)
+		{
+			typedef typename std::remove_const<typename std::remove_pointer<typename range_type::first_type>::type>::type source_char;
+			const range_type range = std_str_converter::range(element);
+			if(quoting_length(range, delimiter) == 0)
+			{
+				return write_range(first, last, range.first, range.second);
+			}
+			if(first == last)
+			{
+				return NULL;
+			}
+			*first++ = static_cast<CharT>('"');
+			// each segment is written with its closing '"', and the '"' is written again
+			for(typename range_type::first_type segment = range.first; ; )
+			{
+				typename range_type::first_type quote = std::find(segment, range.second, static_cast<source_char>('"'));
+				first = write_range(first, last, segment, quote == range.second ? quote : quote + 1);
+				if(!first || first == last)
+				{
+					return NULL;
+				}
+				*first++ = static_cast<CharT>('"');
+				if(quote == range.second)
+				{
+					break;
+				}
+				segment = quote + 1;
+			}
+			return first;
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief text of elements, which is written by element_text of each element
+	 *
+	 *	length_bound is computed in a pre-pass over the elements, so the text is written with one allocation.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	struct element_length_bound
+	{
+		size_t length;
+		CharT delimiter;
+		template<typename T>
+		void operator()(const T& element)
+		{
+			length += element_text<T>::length_bound(element, delimiter);
+		}
+	};
+	template<typename CharT>
+	struct element_writer
+	{
+		CharT* first;
+		CharT* last;
+		CharT delimiter;
+		bool leading;
+		template<typename T>
+		void operator()(const T& element)
+		{
+			if(!first)
+			{
+				return;
+			}
+			if(!leading)
+			{
+				if(first == last)
+				{
+					first = NULL;
+					return;
+				}
+				*first++ = delimiter;
+			}
+			leading = false;
+			first = element_text<T>::write(first, last, element, delimiter);
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief elements of container
+	 *
+	 *	visit calls visitor with each element in order, parse assigns the fields of reader to the elements.
+	 *	fields after the last element are ignored, and elements after the last field are value initialized.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename Container>
+	struct container_elements;
+
+	template<typename T, typename Alloc>
+	struct container_elements<std::vector<T, Alloc> >
+	{
+		static size_t size(const std::vector<T, Alloc>& container)	{ return container.size(); }
+		template<typename Visitor>
+		static void visit(const std::vector<T, Alloc>& container, Visitor& visitor)
+		{
+			for(size_t i = 0; i < container.size(); ++i)
+			{
+				visitor(container[i]);
+			}
+		}
+		template<typename CharT>
+		static void parse(std::vector<T, Alloc>& container, field_reader<CharT>& reader)
+		{
+			container.reserve(container.size() + reader.count());
+			const CharT* first;
+			const CharT* last;
+			while(reader.read(first, last))
+			{
+				container.push_back(element_parser<T>::parse(first, last));
+			}
+		}
+	};
+
+	template<typename T, size_t N>
+	struct container_elements<std::array<T, N> >
+	{
+		static size_t size(const std::array<T, N>&)	{ return N; }
+		template<typename Visitor>
+		static void visit(const std::array<T, N>& container, Visitor& visitor)
+		{
+			for(size_t i = 0; i < N; ++i)
+			{
+				visitor(container[i]);
+			}
+		}
+		template<typename CharT>
+		static void parse(std::array<T, N>& container, field_reader<CharT>& reader)
+		{
+			const CharT* first;
+			const CharT* last;
+			for(size_t i = 0; i < N && reader.read(first, last); ++i)
+			{
+				container[i] = element_parser<T>::parse(first, last);
+			}
+		}
+	};
+
+	template<typename First, typename Second>
+	struct container_elements<std::pair<First, Second> >
+	{
+		static size_t size(const std::pair<First, Second>&)	{ return 2; }
+		template<typename Visitor>
+		static void visit(const std::pair<First, Second>& container, Visitor& visitor)
+		{
+			visitor(container.first);
+			visitor(container.second);
+		}
+		template<typename CharT>
+		static void parse(std::pair<First, Second>& container, field_reader<CharT>& reader)
+		{
+			const CharT* first;
+			const CharT* last;
+			if(reader.read(first, last))
+			{
+				container.first = element_parser<First>::parse(first, last);
+			}
+			if(reader.read(first, last))
+			{
+				container.second = element_parser<Second>::parse(first, last);
+			}
+		}
+	};
+
+	// elements of std::tuple are visited from Index to the last
+	template<typename Tuple, size_t Index = 0, bool End = Index == std::tuple_size<Tuple>::value>
+	struct tuple_elements
+	{
+		typedef typename std::tuple_element<Index, Tuple>::type element_type;
+		template<typename Visitor>
+		static void visit(const Tuple& container, Visitor& visitor)
+		{
+			visitor(std::get<Index>(container));
+			tuple_elements<Tuple, Index + 1>::visit(container, visitor);
+		}
+		template<typename CharT>
+		static void parse(Tuple& container, field_reader<CharT>& reader)
+		{
+			const CharT* first;
+			const CharT* last;
+			if(reader.read(first, last))
+			{
+				std::get<Index>(container) = element_parser<element_type>::parse(first, last);
+				tuple_elements<Tuple, Index + 1>::parse(container, reader);
+			}
+		}
+	};
+	template<typename Tuple, size_t Index>
+	struct tuple_elements<Tuple, Index, true>
+	{
+		template<typename Visitor>
+		static void visit(const Tuple&, Visitor&)
+		{
+		}
+		template<typename CharT>
+		static void parse(Tuple&, field_reader<CharT>&)
+		{
+		}
+	};
+
+	template<typename... Types>
+	struct container_elements<std::tuple<Types...> > : tuple_elements<std::tuple<Types...> >
+	{
+		static size_t size(const std::tuple<Types...>&)	{ return sizeof...(Types); }
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief upper bound of the number of characters of delimited text of container
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename Container>
+	inline size_t join_length_bound(const Container& container, CharT delimiter)
+	{
+		const size_t size = container_elements<Container>::size(container);
+		element_length_bound<CharT> bound = { size == 0 ? 0 : size - 1, delimiter };
+		container_elements<Container>::visit(container, bound);
+		return bound.length;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write delimited text of container to buffer
+	 * @return one past the last character written, or NULL if the text does not fit in [first, last)
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename Container>
+	inline CharT* join_write(CharT* first, CharT* last, const Container& container, CharT delimiter)
+	{
+		element_writer<CharT> writer = { first, last, delimiter, true };
+		container_elements<Container>::visit(container, writer);
+		return writer.first;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief append delimited text of container to string
+	 *
+	 *	the string is resized once to the upper bound of the text, and shrunk to the written text without reallocation.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType, typename Container>
+	inline void join_append(StdStrType& dst, const Container& container, typename StdStrType::value_type delimiter)
+	{
+		typedef typename StdStrType::value_type char_type;
+		const size_t bound = join_length_bound(container, delimiter);
+		if(bound == 0)
+		{
+			return;
+		}
+		const size_t size = dst.size();
+		dst.resize(size + bound);
+		char_type* const first = &dst[0] + size;
+		dst.resize(size + static_cast<size_t>(join_write(first, first + bound, container, delimiter) - first));
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief container parsed from delimited text
+	 *
+	 *	the fields are parsed in place, no string is built for a numeric element.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename Container, typename CharT>
+	inline Container split(const CharT* first, const CharT* last, CharT delimiter)
+	{
+		Container container = Container();
+		field_reader<CharT> reader(first, last, delimiter);
+		container_elements<Container>::parse(container, reader);
+		return container;
+	}
+
+	template<typename Container, typename StdStrType>
+	struct container_string_converter : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef Container value_type, reduction_type;
+		typedef std::string handle_type;
+		static std_str_type to_string(const value_type& val)
+		{
+			std_str_type text;
+			join_append(text, val, default_delimiter::value);
+			return text;
+		}
+		static reduction_type reduction(const StdStrType& string)
+		{
+			return split<Container>(string.data(), string.data() + string.size(), static_cast<typename StdStrType::value_type>(default_delimiter::value));
+		}
+	};
+
+	template<typename Container>
+	struct container_type_traits
+	{
+		typedef Container original_type, tagged_type;
+		typedef container_type type_info;
+		typedef string_converter<tagged_type, std::string> std_str_converter;
+	};
+
+	template<typename T, typename Alloc, typename StdStrType>
+	struct string_converter<std::vector<T, Alloc>, StdStrType> : container_string_converter<std::vector<T, Alloc>, StdStrType>
+	{
+	};
+	template<typename T, size_t N, typename StdStrType>
+	struct string_converter<std::array<T, N>, StdStrType> : container_string_converter<std::array<T, N>, StdStrType>
+	{
+	};
+	template<typename First, typename Second, typename StdStrType>
+	struct string_converter<std::pair<First, Second>, StdStrType> : container_string_converter<std::pair<First, Second>, StdStrType>
+	{
+	};
+	template<typename... Types, typename StdStrType>
+	struct string_converter<std::tuple<Types...>, StdStrType> : container_string_converter<std::tuple<Types...>, StdStrType>
+	{
+	};
+
+	template<typename T, typename Alloc>
+	struct type_traits<std::vector<T, Alloc> > : container_type_traits<std::vector<T, Alloc> >
+	{
+	};
+	template<typename T, size_t N>
+	struct type_traits<std::array<T, N> > : container_type_traits<std::array<T, N> >
+	{
+	};
+	template<typename First, typename Second>
+	struct type_traits<std::pair<First, Second> > : container_type_traits<std::pair<First, Second> >
+	{
+	};
+	template<typename... Types>
+	struct type_traits<std::tuple<Types...> > : container_type_traits<std::tuple<Types...> >
+	{
+	};
+
+	// "From" is container, its elements are joined by the default delimiter
+	template<typename From>
+	struct append_executor<From, container_type>
+	{
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const From& from)
+		{
+			join_append(dst, from, default_delimiter::value);
+		}
+		template<typename CharT>
+		static CharT* write(CharT* first, CharT* last, const From& from)
+		{
+			return join_write(first, last, from, static_cast<CharT>(default_delimiter::value));
+		}
+		template<typename CharT>
+		static size_t length_bound(const From& from)
+		{
+			return join_length_bound(from, static_cast<CharT>(default_delimiter::value));
+		}
+	};
+
+	template<typename T, typename Alloc>
+	struct is_appendable<std::vector<T, Alloc> > : std::true_type
+	{
+	};
+	template<typename T, size_t N>
+	struct is_appendable<std::array<T, N> > : std::true_type
+	{
+	};
+	template<typename First, typename Second>
+	struct is_appendable<std::pair<First, Second> > : std::true_type
+	{
+	};
+	template<typename... Types>
+	struct is_appendable<std::tuple<Types...> > : std::true_type
+	{
+	};
+
+	/** character type of the range of string type */
+	template<typename From>
+	struct range_char_type
+	{
+		typedef typename type_traits<From>::std_str_converter::range_type::first_type pointer;
+		typedef typename std::remove_const<typename std::remove_pointer<pointer>::type>::type type;
+	};
+
+	// "To" is container and "From" is string type, the fields split by Delimiter are parsed through the characters of "From" without copying
+	template<
+		typename To,
+		typename From,
+		typename Delimiter = default_delimiter
+	>
+	struct split_executor
+	{
+		typedef To return_type;
+		static return_type cast(const From& from)
+		{
+			static_assert(std::is_same<typename type_traits<From>::type_info, string_type>::value, "container is split only from string type. check From type.");
+			typedef typename type_traits<From>::std_str_converter std_str_converter;
+			const typename std_str_converter::range_type range = std_str_converter::range( from );
+			return split<To>(range.first, range.second, static_cast<typename range_char_type<From>::type>(Delimiter::value));
+		}
+	};
+
+	// "To" is string type and "From" is container, the elements are joined by Delimiter(std::basic_string is written directly)
+	template<
+		typename To,
+		typename From,
+		typename Delimiter
+	>
+	struct join_executor
+	{
+		typedef typename type_traits<To>::std_str_converter std_str_converter;
+		typedef typename std_str_converter::handle_type handle_type;
+		typedef To return_type;
+		static return_type cast(const From& from)
+		{
+			static_assert(std::is_same<typename type_traits<From>::type_info, container_type>::value, "only container is joined. check From type.");
+			handle_type text;
+			join_append(text, from, static_cast<typename handle_type::value_type>(Delimiter::value));
+			return std_str_converter::reduction(text);
+		}
+	};
+	template<
+		typename CharT,
+		typename Traits,
+		typename Alloc,
+		typename From,
+		typename Delimiter
+	>
+	struct join_executor<std::basic_string<CharT, Traits, Alloc>, From, Delimiter>
+	{
+		typedef std::basic_string<CharT, Traits, Alloc> return_type;
+		static return_type cast(const From& from)
+		{
+			static_assert(std::is_same<typename type_traits<From>::type_info, container_type>::value, "only container is joined. check From type.");
+			return_type text;
+			join_append(text, from, static_cast<CharT>(Delimiter::value));
+			return text;
+		}
+	};
+
+	// container is split from string, and string is joined from container
+	template<
+		typename To,
+		typename From,
+		typename Delimiter
+	>
+	struct delimited_executor
+		: std::conditional<
+			std::is_same<typename type_traits<To>::type_info, container_type>::value,
+			split_executor<To, From, Delimiter>,
+			join_executor<To, From, Delimiter>
+		>::type
+	{
+	};
+
+	template<
+		typename To,
+		typename From
+	>
+	struct cast_executor<To, From, container_type, string_type> : split_executor<To, From>
+	{
+	};
+}	// End Of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   intelligent cast with delimiter policy
+ * @param[in] from container to be joined, or string to be split
+ * @returns string of To type joined by Delimiter, or container of To type split by Delimiter
+ *
+ * Delimiter is intelligent_cast_fmt::delimited, such as intelligent_cast<std::vector<double>, intelligent_cast_fmt::delimited<';'> >("1.5;2;3").
+ * the text is sized by a pre-pass over the elements and written with one allocation,
+ * and each field is parsed in place after the container is reserved for the number of delimiters.
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename Delimiter, typename From>
+typename std::enable_if<
+	intelligent_cast_detail::is_delimiter_policy<Delimiter>::value,
+	typename intelligent_cast_detail::delimited_executor<To, From, Delimiter>::return_type
+>::type
+intelligent_cast(const From& from)
+{
+	return intelligent_cast_detail::delimited_executor<To, From, Delimiter>::cast(from);
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   append elements of container joined by delimiter policy to string
+ * @param[in,out] dst std::basic_string of char or wchar_t with any allocator, which is appended to
+ * @param[in] from std::vector, std::array, std::pair or std::tuple
+ * @returns dst
+ */
+//---------------------------------------------------------------------------
+template<typename Delimiter, typename CharT, typename From, typename Traits, typename Alloc>
+typename std::enable_if<intelligent_cast_detail::is_delimiter_policy<Delimiter>::value, std::basic_string<CharT, Traits, Alloc>&>::type
+intelligent_cast_append(std::basic_string<CharT, Traits, Alloc>& dst, const From& from)
+{
+	static_assert(std::is_same<typename intelligent_cast_detail::type_traits<From>::type_info, intelligent_cast_detail::container_type>::value, "only container is joined. check From type.");
+	intelligent_cast_detail::join_append(dst, from, static_cast<CharT>(Delimiter::value));
+	return dst;
+}
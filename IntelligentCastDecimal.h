@@ -0,0 +1,303 @@
+#pragma once
+#include <limits>
+#include <string>
+#include <type_traits>
+#include "IntelligentCast.h"
+
+//---------------------------------------------------------------------------
+// intelligent_cast_decimal<Scale> is a fixed-point decimal number held as a count of 10^-Scale units in long long.
+// it is parsed from and formatted to text in one pass without floating point, so "123.4500" is held exactly.
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+/**
+ * @brief fixed-point decimal number with Scale digits after the decimal point
+ * @param Scale number of fraction digits, at most 18
+ *
+ *	intelligent_cast_decimal<4> holds 123.45 as 1234500 units. the text always has Scale fraction digits ("123.4500").\n
+ *	when parsed, fraction digits beyond Scale must be zeros, otherwise parsing stops at the first non zero one,
+ *	so try_intelligent_cast reports trailing_characters instead of rounding silently.
+ */
+//---------------------------------------------------------------------------
+template<unsigned int Scale>
+class intelligent_cast_decimal
+{
+	static_assert(Scale <= 18, "Scale of intelligent_cast_decimal must not be greater than 18.");
+public:
+	static const unsigned int scale = Scale;
+
+	intelligent_cast_decimal()
+		: units_(0)
+	{
+	}
+	/** intelligent_cast_decimal of units * 10^-Scale */
+	static intelligent_cast_decimal from_units(long long units)
+	{
+		intelligent_cast_decimal result;
+		result.units_ = units;
+		return result;
+	}
+	/** value in units of 10^-Scale */
+	long long units() const		{ return units_; }
+
+private:
+	long long units_;
+};
+
+template<unsigned int Scale>
+inline bool operator==(const intelligent_cast_decimal<Scale>& lhs, const intelligent_cast_decimal<Scale>& rhs)
+{
+	return lhs.units() == rhs.units();
+}
+template<unsigned int Scale>
+inline bool operator!=(const intelligent_cast_decimal<Scale>& lhs, const intelligent_cast_decimal<Scale>& rhs)
+{
+	return !(lhs == rhs);
+}
+template<unsigned int Scale>
+inline bool operator<(const intelligent_cast_decimal<Scale>& lhs, const intelligent_cast_decimal<Scale>& rhs)
+{
+	return lhs.units() < rhs.units();
+}
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief 10^Exponent
+	 */
+	//---------------------------------------------------------------------------
+	template<unsigned int Exponent>
+	struct decimal_unit
+	{
+		static const unsigned long long value = 10u * decimal_unit<Exponent - 1>::value;
+	};
+	template<>
+	struct decimal_unit<0>
+	{
+		static const unsigned long long value = 1u;
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief sign, integer part and fraction part of decimal
+	 *
+	 *	magnitude of negative value is computed in unsigned arithmetic not to overflow at the minimum value.
+	 */
+	//---------------------------------------------------------------------------
+	template<unsigned int Scale>
+	struct fixed_point_digits
+	{
+		explicit fixed_point_digits(const intelligent_cast_decimal<Scale>& src)
+			: negative(src.units() < 0)
+		{
+			const unsigned long long magnitude = negative ? 0u - static_cast<unsigned long long>(src.units()) : static_cast<unsigned long long>(src.units());
+			integer = magnitude / decimal_unit<Scale>::value;
+			fraction = magnitude % decimal_unit<Scale>::value;
+			length = (negative ? 1 : 0) + count_digits(integer) + (Scale ? 1 + static_cast<int>(Scale) : 0);
+		}
+		/** write exactly length characters from out */
+		template<typename CharT>
+		void write(CharT* out) const
+		{
+			*out = static_cast<CharT>('-');
+			CharT* const point = out + length - (Scale ? 1 + static_cast<int>(Scale) : 0);
+			write_digits(point, integer);
+			if(Scale)
+			{
+				*point = static_cast<CharT>('.');
+				CharT* const fraction_first = point + 1;
+				const int fraction_digits = fraction ? count_digits(fraction) : 0;
+				for(int i = 0; i < static_cast<int>(Scale) - fraction_digits; ++i)
+				{
+					fraction_first[i] = static_cast<CharT>('0');
+				}
+				if(fraction)
+				{
+					write_digits(fraction_first + Scale, fraction);
+				}
+			}
+		}
+
+		bool negative;
+		unsigned long long integer;
+		unsigned long long fraction;
+		int length;
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief parse decimal from character range
+	 * @return one past the last character parsed, or first if no digit is found
+	 * @param[in]	first : first character
+	 * @param[in]	last : one past the last character
+	 * @param[out]	value : parsed value, 0 if no digit is found
+	 * @param[out]	out_of_range : true if the parsed number is not representable in long long units
+	 *
+	 *	leading white spaces and a sign are accepted like parse_integral, and the digits are accumulated into the units directly.
+	 *	range is checked while digits are accumulated, an out of range value saturates to the limit of long long.
+	 *	fraction digits beyond Scale are parsed only while they are zeros.
+	 */
+	//---------------------------------------------------------------------------
+	template<unsigned int Scale, typename CharT>
+	inline const CharT* parse_fixed_point(const CharT* first, const CharT* last, intelligent_cast_decimal<Scale>& value, bool& out_of_range)
+	{
+		const CharT* const begin = first;
+		while(first != last && is_space(*first))
+		{
+			++first;
+		}
+		bool negative = false;
+		if(first != last && (*first == static_cast<CharT>('-') || *first == static_cast<CharT>('+')))
+		{
+			negative = *first == static_cast<CharT>('-');
+			++first;
+		}
+
+		// magnitude of the minimum value is one more than the maximum value
+		const unsigned long long limit = static_cast<unsigned long long>((std::numeric_limits<long long>::max)()) + (negative ? 1u : 0u);
+		unsigned long long magnitude = 0;
+		bool overflow = false;
+		const CharT* const digits_begin = first;
+		for(; first != last; ++first)
+		{
+			const unsigned int digit = static_cast<unsigned int>(*first - static_cast<CharT>('0'));
+			if(digit > 9u)
+			{
+				break;
+			}
+			if(magnitude <= (limit - digit) / 10u)
+			{
+				magnitude = magnitude * 10u + digit;
+			}
+			else
+			{
+				overflow = true;
+			}
+		}
+		bool has_digits = first != digits_begin;
+		unsigned int fraction_digits = 0;
+		if(first != last && *first == static_cast<CharT>('.'))
+		{
+			const CharT* p = first + 1;
+			for(; p != last && fraction_digits < Scale; ++p, ++fraction_digits)
+			{
+				const unsigned int digit = static_cast<unsigned int>(*p - static_cast<CharT>('0'));
+				if(digit > 9u)
+				{
+					break;
+				}
+				if(magnitude <= (limit - digit) / 10u)
+				{
+					magnitude = magnitude * 10u + digit;
+				}
+				else
+				{
+					overflow = true;
+				}
+			}
+			// zeros beyond Scale do not change the value
+			while(p != last && *p == static_cast<CharT>('0'))
+			{
+				++p;
+			}
+			if(has_digits || p != first + 1)
+			{
+				has_digits = true;
+				first = p;
+			}
+		}
+		if(!has_digits)
+		{
+			value = intelligent_cast_decimal<Scale>();
+			out_of_range = false;
+			return begin;
+		}
+		// fraction digits which are not written are zeros
+		for(; fraction_digits < Scale; ++fraction_digits)
+		{
+			if(magnitude <= limit / 10u)
+			{
+				magnitude *= 10u;
+			}
+			else
+			{
+				overflow = true;
+			}
+		}
+		if(overflow)
+		{
+			magnitude = limit;
+		}
+		out_of_range = overflow;
+		value = intelligent_cast_decimal<Scale>::from_units(static_cast<long long>(negative ? 0u - magnitude : magnitude));
+		return first;
+	}
+
+	template<unsigned int Scale, typename StdStrType>
+	struct string_converter<intelligent_cast_decimal<Scale>, StdStrType> : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef intelligent_cast_decimal<Scale> value_type;
+		typedef typename StdStrType::value_type char_type;
+		static std_str_type to_string(const value_type& val)
+		{
+			const fixed_point_digits<Scale> digits(val);
+			std_str_type text(static_cast<size_t>(digits.length), char_type());
+			digits.write(&text[0]);
+			return text;
+		}
+		static const char_type* parse(const char_type* first, const char_type* last, value_type& value, bool& out_of_range)
+		{
+			return parse_fixed_point(first, last, value, out_of_range);
+		}
+		static value_type get_value(const char_type* first, const char_type* last)
+		{
+			value_type value;
+			bool out_of_range;
+			parse(first, last, value, out_of_range);
+			return value;
+		}
+		static value_type get_value(const StdStrType& str)	{ return get_value(str.data(), str.data() + str.size()); }
+	};
+
+	// intelligent_cast_decimal is converted like a numeric value, so it is parsed in place and written without an intermediate string
+	template<unsigned int Scale>
+	struct type_traits<intelligent_cast_decimal<Scale> >
+	{
+		typedef intelligent_cast_decimal<Scale> original_type, tagged_type;
+		typedef numeric_type type_info;
+	};
+
+	template<unsigned int Scale>
+	struct append_executor<intelligent_cast_decimal<Scale>, numeric_type>
+	{
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const intelligent_cast_decimal<Scale>& from)
+		{
+			const fixed_point_digits<Scale> digits(from);
+			const size_t size = dst.size();
+			dst.resize(size + digits.length);
+			digits.write(&dst[0] + size);
+		}
+		template<typename CharT>
+		static CharT* write(CharT* first, CharT* last, const intelligent_cast_decimal<Scale>& from)
+		{
+			const fixed_point_digits<Scale> digits(from);
+			if(last - first < digits.length)
+			{
+				return NULL;
+			}
+			digits.write(first);
+			return first + digits.length;
+		}
+		template<typename CharT>
+		static size_t length_bound(const intelligent_cast_decimal<Scale>& from)
+		{
+			return static_cast<size_t>(fixed_point_digits<Scale>(from).length);
+		}
+	};
+
+	template<unsigned int Scale>
+	struct is_appendable<intelligent_cast_decimal<Scale> > : std::true_type
+	{
+	};
+}	// End Of Namespace intelligent_cast_detail
@@ -0,0 +1,423 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include "IntelligentCast.h"
+
+//---------------------------------------------------------------------------
+// conversion between types which are known only at runtime, such as the columns of a database or the keys of a config.
+// the tags and the dense table of converters are generated from INTELLIGENT_CAST_NUMERIC_TYPES,
+// so a cell is converted by one indirect call without boxing.
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+/**
+ * @brief type of intelligent_cast_value
+ *
+ *	numeric tags are named after INTELLIGENT_CAST_NUMERIC_TYPES (int_, double_ and so on),
+ *	string_ is text of char and wstring_ is text of wchar_t.
+ */
+//---------------------------------------------------------------------------
+#define INTELLIGENT_CAST_DISPATCH_TAG(type, name) name,
+enum class intelligent_cast_tag
+{
+	INTELLIGENT_CAST_NUMERIC_TYPES(INTELLIGENT_CAST_DISPATCH_TAG)
+	string_,
+	wstring_
+};
+#undef INTELLIGENT_CAST_DISPATCH_TAG
+
+/** the number of intelligent_cast_tag */
+const size_t intelligent_cast_tag_count = static_cast<size_t>(intelligent_cast_tag::wstring_) + 1;
+
+//---------------------------------------------------------------------------
+/**
+ * @brief text in intelligent_cast_value
+ *
+ *	[data, data + size) is the text. as the destination of conversion, the text is written to [buffer, buffer + capacity)
+ *	and data points to buffer, or to the source text when it has the same character type.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT>
+struct intelligent_cast_text
+{
+	const CharT* data;
+	size_t size;
+	CharT* buffer;
+	size_t capacity;
+};
+
+//---------------------------------------------------------------------------
+/**
+ * @brief value slot of any type of intelligent_cast_tag
+ *
+ *	the value is held in place and text is referred, so a slot is never allocated.
+ */
+//---------------------------------------------------------------------------
+struct intelligent_cast_value
+{
+	intelligent_cast_tag tag;
+	union
+	{
+#define INTELLIGENT_CAST_DISPATCH_MEMBER(type, name) type name;
+		INTELLIGENT_CAST_NUMERIC_TYPES(INTELLIGENT_CAST_DISPATCH_MEMBER)
+#undef INTELLIGENT_CAST_DISPATCH_MEMBER
+		intelligent_cast_text<char> string_;
+		intelligent_cast_text<wchar_t> wstring_;
+	};
+
+	/** slot of source text [first, last) */
+	static intelligent_cast_value text(const char* first, const char* last)
+	{
+		intelligent_cast_value value;
+		value.tag = intelligent_cast_tag::string_;
+		value.string_ = make_text(first, last, static_cast<char*>(NULL), static_cast<char*>(NULL));
+		return value;
+	}
+	static intelligent_cast_value text(const wchar_t* first, const wchar_t* last)
+	{
+		intelligent_cast_value value;
+		value.tag = intelligent_cast_tag::wstring_;
+		value.wstring_ = make_text(first, last, static_cast<wchar_t*>(NULL), static_cast<wchar_t*>(NULL));
+		return value;
+	}
+	/** slot of destination text, which is written to [first, last) */
+	static intelligent_cast_value buffer(char* first, char* last)
+	{
+		intelligent_cast_value value;
+		value.tag = intelligent_cast_tag::string_;
+		value.string_ = make_text(static_cast<const char*>(first), static_cast<const char*>(first), first, last);
+		return value;
+	}
+	static intelligent_cast_value buffer(wchar_t* first, wchar_t* last)
+	{
+		intelligent_cast_value value;
+		value.tag = intelligent_cast_tag::wstring_;
+		value.wstring_ = make_text(static_cast<const wchar_t*>(first), static_cast<const wchar_t*>(first), first, last);
+		return value;
+	}
+	/** slot of numeric value, or of numeric type to be converted to by numeric(T()) */
+	template<typename T>
+	static intelligent_cast_value numeric(T number);
+	/**
+	 * slot of numeric type given at runtime, with value 0.
+	 * a text tag gives empty text without buffer, so a conversion to it reports buffer_too_small.
+	 */
+	static intelligent_cast_value numeric(intelligent_cast_tag tag)
+	{
+		intelligent_cast_value value;
+		value.tag = tag;
+		if(tag == intelligent_cast_tag::string_)
+		{
+			value.string_ = intelligent_cast_text<char>();
+		}
+		else if(tag == intelligent_cast_tag::wstring_)
+		{
+			value.wstring_ = intelligent_cast_text<wchar_t>();
+		}
+		else
+		{
+			// every numeric member is at most 8 bytes, and all bits zero is 0 of any type
+			value.ulonglong_ = 0;
+		}
+		return value;
+	}
+
+	/** value of numeric type T, which must be the type of tag */
+	template<typename T>
+	T& get();
+	template<typename T>
+	const T& get() const;
+
+private:
+	template<typename CharT>
+	static intelligent_cast_text<CharT> make_text(const CharT* first, const CharT* last, CharT* buffer_first, CharT* buffer_last)
+	{
+		const intelligent_cast_text<CharT> text = { first, static_cast<size_t>(last - first), buffer_first, static_cast<size_t>(buffer_last - buffer_first) };
+		return text;
+	}
+};
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief type of each tag, and member of intelligent_cast_value which holds it
+	 */
+	//---------------------------------------------------------------------------
+	template<intelligent_cast_tag Tag>
+	struct dispatch_tag_type;
+
+	template<typename T>
+	struct dispatch_member;
+
+#define INTELLIGENT_CAST_DISPATCH_TYPE(type, name) \
+	template<> struct dispatch_tag_type<intelligent_cast_tag::name> \
+	{ \
+		typedef type type_; \
+	}; \
+	template<> struct dispatch_member<type> \
+	{ \
+		static const intelligent_cast_tag tag = intelligent_cast_tag::name; \
+		static type& get(intelligent_cast_value& value)				{ return value.name; } \
+		static const type& get(const intelligent_cast_value& value)	{ return value.name; } \
+	};
+	INTELLIGENT_CAST_NUMERIC_TYPES(INTELLIGENT_CAST_DISPATCH_TYPE)
+	INTELLIGENT_CAST_DISPATCH_TYPE(intelligent_cast_text<char>, string_)
+	INTELLIGENT_CAST_DISPATCH_TYPE(intelligent_cast_text<wchar_t>, wstring_)
+#undef INTELLIGENT_CAST_DISPATCH_TYPE
+
+	template<size_t Index>
+	struct dispatch_index_type : dispatch_tag_type<static_cast<intelligent_cast_tag>(Index)>
+	{
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief numeric value cast to another numeric type with range check
+	 * @return false if the value is not representable in To, and then to is saturated like try_intelligent_cast
+	 *
+	 *	integral value beyond the range of integral To, floating point value whose integral part is beyond it or NaN,
+	 *	and finite non zero floating point value which becomes infinity or zero in floating point To are out of range.
+	 *	integral value is always in the range of floating point To, though it may be rounded.
+	 */
+	//---------------------------------------------------------------------------
+	template<
+		typename To,
+		typename From,
+		bool ToIntegral = std::is_integral<To>::value,
+		bool FromIntegral = std::is_integral<From>::value
+	>
+	struct numeric_range_cast;
+
+	template<typename T>
+	inline bool is_negative(T value, std::true_type)	{ return value < static_cast<T>(0); }
+	template<typename T>
+	inline bool is_negative(T, std::false_type)			{ return false; }
+
+	// integral -> integral, compared as long long below 0 and as unsigned long long above 0
+	template<typename To, typename From>
+	struct numeric_range_cast<To, From, true, true>
+	{
+		static bool cast(From from, To& to)
+		{
+			const bool negative = is_negative(from, std::integral_constant<bool, std::numeric_limits<From>::is_signed>());
+			const bool below = negative && (!std::numeric_limits<To>::is_signed || static_cast<long long>(from) < static_cast<long long>(std::numeric_limits<To>::min()));
+			const bool above = !negative && static_cast<unsigned long long>(from) > static_cast<unsigned long long>(std::numeric_limits<To>::max());
+			to = below ? std::numeric_limits<To>::min() : above ? std::numeric_limits<To>::max() : static_cast<To>(from);
+			return !below && !above;
+		}
+	};
+	// floating point -> integral, the integral part must be in [-2^digits, 2^digits) for signed To and in [0, 2^digits) for unsigned To
+	template<typename To, typename From>
+	struct numeric_range_cast<To, From, true, false>
+	{
+		static bool cast(From from, To& to)
+		{
+			const From limit = static_cast<From>(1ULL << (std::numeric_limits<To>::digits - 1)) * 2;
+			const From integral = std::trunc(from);
+			const bool below = integral < (std::numeric_limits<To>::is_signed ? -limit : static_cast<From>(0));
+			const bool above = integral >= limit;
+			const bool nan = from != from;
+			to = nan ? static_cast<To>(0) : below ? std::numeric_limits<To>::min() : above ? std::numeric_limits<To>::max() : static_cast<To>(from);
+			return !nan && !below && !above;
+		}
+	};
+	// integral -> floating point
+	template<typename To, typename From>
+	struct numeric_range_cast<To, From, false, true>
+	{
+		static bool cast(From from, To& to)
+		{
+			to = static_cast<To>(from);
+			return true;
+		}
+	};
+	// floating point -> floating point, overflow is saturated to infinity and underflow to zero as parse_floating
+	template<typename To, typename From>
+	struct numeric_range_cast<To, From, false, false>
+	{
+		static bool cast(From from, To& to)
+		{
+			if(std::isfinite(from) && std::fabs(from) > std::numeric_limits<To>::max())
+			{
+				to = from < 0 ? -std::numeric_limits<To>::infinity() : std::numeric_limits<To>::infinity();
+				return false;
+			}
+			to = static_cast<To>(from);
+			return to != 0 || from == 0 || from != from;
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief converter of one cell of the table
+	 *
+	 *	numeric value is cast with the range check of numeric_range_cast, text is parsed with the errors of try_intelligent_cast,
+	 *	and numeric value or text of another character type is written to the buffer of the destination.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename From, typename To>
+	struct dispatch_cell
+	{
+		static intelligent_cast_errc convert(const intelligent_cast_value& from, intelligent_cast_value& to)
+		{
+			return numeric_range_cast<To, From>::cast(dispatch_member<From>::get(from), dispatch_member<To>::get(to)) ? intelligent_cast_errc::ok : intelligent_cast_errc::out_of_range;
+		}
+	};
+	// numeric value -> text
+	template<typename From, typename CharT>
+	struct dispatch_cell<From, intelligent_cast_text<CharT> >
+	{
+		static intelligent_cast_errc convert(const intelligent_cast_value& from, intelligent_cast_value& to)
+		{
+			intelligent_cast_text<CharT>& text = dispatch_member<intelligent_cast_text<CharT> >::get(to);
+			CharT* const last = write_format(text.buffer, text.buffer + text.capacity, dispatch_member<From>::get(from));
+			text.data = text.buffer;
+			text.size = last ? static_cast<size_t>(last - text.buffer) : 0;
+			return last ? intelligent_cast_errc::ok : intelligent_cast_errc::buffer_too_small;
+		}
+	};
+	// text -> numeric value
+	template<typename CharT, typename To>
+	struct dispatch_cell<intelligent_cast_text<CharT>, To>
+	{
+		static intelligent_cast_errc convert(const intelligent_cast_value& from, intelligent_cast_value& to)
+		{
+			const intelligent_cast_text<CharT>& text = dispatch_member<intelligent_cast_text<CharT> >::get(from);
+			const intelligent_cast_result<To> result = try_intelligent_cast<To>(text.data, text.data + text.size);
+			dispatch_member<To>::get(to) = result.value;
+			return result.error;
+		}
+	};
+	// text -> text of another character type
+	template<typename FromCharT, typename ToCharT>
+	struct dispatch_cell<intelligent_cast_text<FromCharT>, intelligent_cast_text<ToCharT> >
+	{
+		static intelligent_cast_errc convert(const intelligent_cast_value& from, intelligent_cast_value& to)
+		{
+			const intelligent_cast_text<FromCharT>& source = dispatch_member<intelligent_cast_text<FromCharT> >::get(from);
+			intelligent_cast_text<ToCharT>& text = dispatch_member<intelligent_cast_text<ToCharT> >::get(to);
+			ToCharT* const last = write_range(text.buffer, text.buffer + text.capacity, source.data, source.data + source.size);
+			text.data = text.buffer;
+			text.size = last ? static_cast<size_t>(last - text.buffer) : 0;
+			return last ? intelligent_cast_errc::ok : intelligent_cast_errc::buffer_too_small;
+		}
+	};
+	// text -> text of the same character type, which is referred without copying
+	template<typename CharT>
+	struct dispatch_cell<intelligent_cast_text<CharT>, intelligent_cast_text<CharT> >
+	{
+		static intelligent_cast_errc convert(const intelligent_cast_value& from, intelligent_cast_value& to)
+		{
+			const intelligent_cast_text<CharT>& source = dispatch_member<intelligent_cast_text<CharT> >::get(from);
+			intelligent_cast_text<CharT>& text = dispatch_member<intelligent_cast_text<CharT> >::get(to);
+			text.data = source.data;
+			text.size = source.size;
+			return intelligent_cast_errc::ok;
+		}
+	};
+
+	template<size_t... Indices>
+	struct index_list
+	{
+	};
+	template<size_t N, size_t... Indices>
+	struct make_index_list : make_index_list<N - 1, N - 1, Indices...>
+	{
+	};
+	template<size_t... Indices>
+	struct make_index_list<0, Indices...>
+	{
+		typedef index_list<Indices...> type;
+	};
+
+	typedef intelligent_cast_errc (*dispatch_converter)(const intelligent_cast_value& from, intelligent_cast_value& to);
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief dense table of converters indexed by (from tag, to tag)
+	 *
+	 *	the table is a constant, which is initialized without code at runtime.
+	 */
+	//---------------------------------------------------------------------------
+	struct dispatch_row
+	{
+		dispatch_converter cells[intelligent_cast_tag_count];
+	};
+	template<size_t From, typename ToIndices>
+	struct dispatch_row_of;
+
+	template<size_t From, size_t... To>
+	struct dispatch_row_of<From, index_list<To...> >
+	{
+		static constexpr dispatch_row row()
+		{
+			return dispatch_row{ { &dispatch_cell<typename dispatch_index_type<From>::type_, typename dispatch_index_type<To>::type_>::convert... } };
+		}
+	};
+
+	template<typename Indices = make_index_list<intelligent_cast_tag_count>::type>
+	struct dispatch_table;
+
+	template<size_t... Indices>
+	struct dispatch_table<index_list<Indices...> >
+	{
+		static const dispatch_row rows[intelligent_cast_tag_count];
+	};
+	template<size_t... Indices>
+	const dispatch_row dispatch_table<index_list<Indices...> >::rows[intelligent_cast_tag_count] =
+	{
+		dispatch_row_of<Indices, index_list<Indices...> >::row()...
+	};
+}	// End Of Namespace intelligent_cast_detail
+
+template<typename T>
+inline intelligent_cast_value intelligent_cast_value::numeric(T number)
+{
+	static_assert(std::is_arithmetic<T>::value, "numeric slot is only for numeric value. use text or buffer for string.");
+	intelligent_cast_value value;
+	value.tag = intelligent_cast_detail::dispatch_member<T>::tag;
+	intelligent_cast_detail::dispatch_member<T>::get(value) = number;
+	return value;
+}
+template<typename T>
+inline T& intelligent_cast_value::get()
+{
+	return intelligent_cast_detail::dispatch_member<T>::get(*this);
+}
+template<typename T>
+inline const T& intelligent_cast_value::get() const
+{
+	return intelligent_cast_detail::dispatch_member<T>::get(*this);
+}
+
+/** converter between two tags, which is called for each cell */
+typedef intelligent_cast_detail::dispatch_converter intelligent_cast_converter;
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   converter between tags known at runtime
+ * @param[in] from tag of source slot
+ * @param[in] to tag of destination slot
+ * @returns converter, which can be looked up once for a column and called for each row
+ */
+//---------------------------------------------------------------------------
+inline intelligent_cast_converter intelligent_cast_dispatch_converter(intelligent_cast_tag from, intelligent_cast_tag to)
+{
+	return intelligent_cast_detail::dispatch_table<>::rows[static_cast<size_t>(from)].cells[static_cast<size_t>(to)];
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   convert value slot to the type of destination slot
+ * @param[in] from source slot
+ * @param[in,out] to destination slot, whose tag is the type converted to. text is written to its buffer
+ * @returns ok, the error of try_intelligent_cast for text to numeric value, or buffer_too_small for text
+ */
+//---------------------------------------------------------------------------
+inline intelligent_cast_errc intelligent_cast_dispatch(const intelligent_cast_value& from, intelligent_cast_value& to)
+{
+	return intelligent_cast_dispatch_converter(from.tag, to.tag)(from, to);
+}
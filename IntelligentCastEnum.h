@@ -0,0 +1,576 @@
+#pragma once
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include "IntelligentCast.h"
+
+#if !(defined(__cpp_constexpr) && __cpp_constexpr >= 201304L) && !(defined(_MSC_VER) && _MSC_VER >= 1910)
+#error "IntelligentCastEnum.h requires C++14 constexpr"
+#endif
+
+//---------------------------------------------------------------------------
+// enum (and bool) is converted to and from the names registered by INTELLIGENT_CAST_ENUM.
+// a name is found by the index of the value, and a value is found by a perfect hash built at compile time.
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+/**
+ * @brief names of Enum, specialized by INTELLIGENT_CAST_ENUM
+ */
+//---------------------------------------------------------------------------
+template<typename Enum>
+struct intelligent_cast_enum_names;
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief errors of building the table of names
+	 *
+	 *	these are not constexpr, so evaluating one of them while the table is built makes the program ill-formed
+	 *	and the compiler reports the name of the error.
+	 */
+	//---------------------------------------------------------------------------
+	inline int enum_name_is_duplicated()			{ return 0; }
+	inline int enum_perfect_hash_is_not_found()		{ return 0; }
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief names of the values 0 to N - 1, NULL for a value without a name
+	 */
+	//---------------------------------------------------------------------------
+	template<size_t N>
+	struct enum_name_list
+	{
+		static const size_t count = N;
+		const char* names[N];
+	};
+	template<size_t N>
+	constexpr enum_name_list<N> make_enum_name_list(const char* const (&names)[N])
+	{
+		enum_name_list<N> list = {};
+		for(size_t i = 0; i < N; ++i)
+		{
+			list.names[i] = names[i];
+		}
+		return list;
+	}
+
+	constexpr size_t enum_name_length(const char* name)
+	{
+		size_t length = 0;
+		while(name && name[length])
+		{
+			++length;
+		}
+		return length;
+	}
+	template<size_t N>
+	constexpr size_t enum_text_size(const enum_name_list<N>& list)
+	{
+		size_t size = 0;
+		for(size_t i = 0; i < N; ++i)
+		{
+			size += enum_name_length(list.names[i]) + 1;
+		}
+		return size;
+	}
+	constexpr unsigned int enum_ceil_log2(size_t n)
+	{
+		unsigned int bits = 0;
+		while((static_cast<size_t>(1) << bits) < n)
+		{
+			++bits;
+		}
+		return bits;
+	}
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief names stored in one array of CharT, each terminated by NUL
+	 *
+	 *	names are ASCII, and they are widened character by character for wchar_t.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, size_t N, size_t Size>
+	struct enum_text
+	{
+		constexpr explicit enum_text(const enum_name_list<N>& list)
+			: characters()
+			, offsets()
+			, lengths()
+			, named()
+		{
+			size_t offset = 0;
+			for(size_t i = 0; i < N; ++i)
+			{
+				const size_t length = enum_name_length(list.names[i]);
+				offsets[i] = offset;
+				lengths[i] = length;
+				named[i] = list.names[i] != NULL;
+				for(size_t c = 0; c < length; ++c)
+				{
+					characters[offset + c] = static_cast<CharT>(static_cast<unsigned char>(list.names[i][c]));
+				}
+				offset += length + 1;
+			}
+		}
+
+		CharT characters[Size];
+		size_t offsets[N];
+		size_t lengths[N];
+		bool named[N];
+	};
+
+	/** finalizer of MurmurHash3, which spreads every bit of hash to the high bits */
+	constexpr unsigned long long enum_mix(unsigned long long hash)
+	{
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ULL;
+		hash ^= hash >> 33;
+		return hash;
+	}
+	template<typename CharT>
+	constexpr unsigned long long enum_code_unit(CharT c)
+	{
+		return static_cast<unsigned long long>(static_cast<typename std::make_unsigned<CharT>::type>(c));
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief hash of characters, which is the same for char and wchar_t of ASCII text
+	 *
+	 *	a sampled hash reads only the length and 4 characters (the first, the last, the middle and the quarter),
+	 *	so it takes the same time for every name. when two names have the same samples, every character is hashed by FNV-1a.
+	 *	the high bits of FNV-1a are biased for short names, so the hash is mixed at the end.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	constexpr unsigned long long enum_hash(const CharT* first, const CharT* last, unsigned long long seed, bool sampled)
+	{
+		const size_t length = static_cast<size_t>(last - first);
+		unsigned long long hash = 14695981039346656037ULL ^ seed;
+		if(sampled)
+		{
+			hash = (hash ^ length) * 1099511628211ULL;
+			if(length)
+			{
+				hash = (hash ^ enum_code_unit(first[0])) * 1099511628211ULL;
+				hash = (hash ^ enum_code_unit(first[length - 1])) * 1099511628211ULL;
+				hash = (hash ^ enum_code_unit(first[length / 2])) * 1099511628211ULL;
+				hash = (hash ^ enum_code_unit(first[length / 4])) * 1099511628211ULL;
+			}
+			return enum_mix(hash);
+		}
+		for(; first != last; ++first)
+		{
+			hash = (hash ^ enum_code_unit(*first)) * 1099511628211ULL;
+		}
+		return enum_mix(hash);
+	}
+	/** slot of hash displaced by displacement, the high bits of the mixed hash are used */
+	constexpr size_t enum_slot(unsigned long long hash, unsigned int displacement, unsigned int slot_bits)
+	{
+		return static_cast<size_t>(enum_mix(hash + displacement * 0x9E3779B97F4A7C15ULL) >> (64 - slot_bits));
+	}
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief minimal-probe perfect hash of N names built in constant expression
+	 *
+	 *	names are divided into buckets by the high bits of the hash, and each bucket has a displacement
+	 *	which places all of its names into empty slots (hash and displace). the table has twice as many slots as names,
+	 *	so a lookup is one hash of the text, two table reads and one compare.
+	 */
+	//---------------------------------------------------------------------------
+	template<size_t N>
+	struct enum_perfect_hash
+	{
+		static_assert(N > 0 && N < 0xFFFF, "the number of enum names must be in [1, 65535).");
+		static const unsigned int slot_bits = enum_ceil_log2(2 * N);
+		static const unsigned int bucket_bits = enum_ceil_log2((N + 1) / 2);
+		static const size_t slot_count = static_cast<size_t>(1) << slot_bits;
+		static const size_t bucket_count = static_cast<size_t>(1) << bucket_bits;
+		static const unsigned int max_displacement = 1u << 12;
+		static const unsigned long long max_seed = 64;
+
+		constexpr explicit enum_perfect_hash(const enum_name_list<N>& list)
+			: seed(0)
+			, sampled(true)
+			, displacements()
+			, slots()
+		{
+			while(!build(list))
+			{
+				if(++seed == max_seed)
+				{
+					enum_perfect_hash_is_not_found();
+					break;
+				}
+			}
+		}
+
+		/** index of the name which may be [first, last), or N if no name can be */
+		template<typename CharT>
+		size_t find(const CharT* first, const CharT* last) const
+		{
+			const unsigned long long hash = enum_hash(first, last, seed, sampled);
+			const size_t slot = enum_slot(hash, displacements[bucket_of(hash)], slot_bits);
+			return slots[slot] ? slots[slot] - 1u : N;
+		}
+
+		unsigned long long seed;
+		bool sampled;							///< whether names are hashed by their samples
+		unsigned int displacements[bucket_count];
+		unsigned short slots[slot_count];		///< index of name + 1, 0 for an empty slot
+
+	private:
+		static constexpr size_t bucket_of(unsigned long long hash)
+		{
+			return bucket_bits ? static_cast<size_t>(hash >> (64 - bucket_bits)) : 0;
+		}
+		constexpr bool build(const enum_name_list<N>& list)
+		{
+			// names are grouped by bucket, members[bucket_first[b], bucket_first[b + 1]) are the names of bucket b
+			unsigned long long hashes[N] = {};
+			size_t bucket_first[bucket_count + 1] = {};
+			size_t cursors[bucket_count] = {};
+			size_t members[N] = {};
+			for(size_t i = 0; i < N; ++i)
+			{
+				const char* const name = list.names[i];
+				hashes[i] = enum_hash(name, name + enum_name_length(name), seed, sampled);
+				if(name)
+				{
+					++bucket_first[bucket_of(hashes[i]) + 1];
+				}
+			}
+			size_t max_size = 0;
+			for(size_t b = 0; b < bucket_count; ++b)
+			{
+				max_size = bucket_first[b + 1] > max_size ? bucket_first[b + 1] : max_size;
+				bucket_first[b + 1] += bucket_first[b];
+				cursors[b] = bucket_first[b];
+			}
+			for(size_t i = 0; i < N; ++i)
+			{
+				if(list.names[i])
+				{
+					members[cursors[bucket_of(hashes[i])]++] = i;
+				}
+			}
+			// names of the same hash are in the same bucket
+			for(size_t m = 0; m < bucket_first[bucket_count]; ++m)
+			{
+				for(size_t n = bucket_first[bucket_of(hashes[members[m]])]; n < m; ++n)
+				{
+					if(hashes[members[m]] == hashes[members[n]])
+					{
+						// the same hash for every seed means the same name, or the same samples of different names
+						if(equal_names(list.names[members[m]], list.names[members[n]]))
+						{
+							enum_name_is_duplicated();
+						}
+						else if(sampled)
+						{
+							sampled = false;
+							return build(list);
+						}
+						return false;
+					}
+				}
+			}
+			for(size_t slot = 0; slot < slot_count; ++slot)
+			{
+				slots[slot] = 0;
+			}
+			for(size_t b = 0; b < bucket_count; ++b)
+			{
+				displacements[b] = 0;
+			}
+			// the largest bucket is placed first, while most slots are empty
+			for(size_t size = max_size; size > 0; --size)
+			{
+				for(size_t b = 0; b < bucket_count; ++b)
+				{
+					if(bucket_first[b + 1] - bucket_first[b] == size && !place(hashes, members + bucket_first[b], size, b))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+		constexpr bool place(const unsigned long long (&hashes)[N], const size_t* members, size_t size, size_t bucket)
+		{
+			for(unsigned int displacement = 0; displacement < max_displacement; ++displacement)
+			{
+				bool fits = true;
+				for(size_t m = 0; m < size && fits; ++m)
+				{
+					const size_t slot = enum_slot(hashes[members[m]], displacement, slot_bits);
+					fits = slots[slot] == 0;
+					for(size_t n = 0; n < m && fits; ++n)
+					{
+						fits = enum_slot(hashes[members[n]], displacement, slot_bits) != slot;
+					}
+				}
+				if(fits)
+				{
+					for(size_t m = 0; m < size; ++m)
+					{
+						slots[enum_slot(hashes[members[m]], displacement, slot_bits)] = static_cast<unsigned short>(members[m] + 1);
+					}
+					displacements[bucket] = displacement;
+					return true;
+				}
+			}
+			return false;
+		}
+		static constexpr bool equal_names(const char* a, const char* b)
+		{
+			for(; *a || *b; ++a, ++b)
+			{
+				if(*a != *b)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief names and perfect hash of Enum, built once at compile time
+	 */
+	//---------------------------------------------------------------------------
+	template<typename Enum>
+	struct enum_table
+	{
+		typedef decltype(intelligent_cast_enum_names<Enum>::list()) list_type;
+		static const size_t count = list_type::count;
+		static constexpr list_type list = intelligent_cast_enum_names<Enum>::list();
+		static constexpr size_t size = enum_text_size(list);
+		typedef enum_text<char, count, size> narrow_type;
+		typedef enum_text<wchar_t, count, size> wide_type;
+		static constexpr narrow_type narrow = narrow_type(list);
+		static constexpr wide_type wide = wide_type(list);
+		static constexpr enum_perfect_hash<count> hash = enum_perfect_hash<count>(list);
+
+		static const narrow_type& text(char)		{ return narrow; }
+		static const wide_type& text(wchar_t)		{ return wide; }
+	};
+	template<typename Enum>
+	constexpr typename enum_table<Enum>::list_type enum_table<Enum>::list;
+	template<typename Enum>
+	constexpr typename enum_table<Enum>::narrow_type enum_table<Enum>::narrow;
+	template<typename Enum>
+	constexpr typename enum_table<Enum>::wide_type enum_table<Enum>::wide;
+	template<typename Enum>
+	constexpr enum_perfect_hash<enum_table<Enum>::count> enum_table<Enum>::hash;
+
+	/** integral value written for a value without a name, bool has names for all of its values */
+	template<typename Enum, bool IsEnum = std::is_enum<Enum>::value>
+	struct enum_number
+	{
+		typedef typename std::underlying_type<Enum>::type type;
+	};
+	template<typename Enum>
+	struct enum_number<Enum, false>
+	{
+		typedef int type;
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief parse registered name from character range
+	 * @return one past the name after leading white spaces, or first if [first, last) does not start with a name
+	 * @param[out]	value : value of the name, Enum() if it is not a name
+	 * @param[out]	out_of_range : always false
+	 *
+	 *	the whole range is looked up by the perfect hash. when it is not a name, the longest name which is a prefix
+	 *	of the range is taken like the numeric parsers, so "red " is reported as trailing_characters after "red".
+	 */
+	//---------------------------------------------------------------------------
+	template<typename Enum, typename CharT>
+	inline const CharT* parse_enum(const CharT* first, const CharT* last, Enum& value, bool& out_of_range)
+	{
+		typedef enum_table<Enum> table;
+		const CharT* const begin = first;
+		while(first != last && is_space(*first))
+		{
+			++first;
+		}
+		out_of_range = false;
+		const auto& text = table::text(CharT());
+		const size_t length = static_cast<size_t>(last - first);
+		const size_t index = table::hash.find(first, last);
+		if(index != table::count && text.lengths[index] == length &&
+			std::char_traits<CharT>::compare(text.characters + text.offsets[index], first, length) == 0)
+		{
+			value = static_cast<Enum>(index);
+			return last;
+		}
+		// the longest name followed by other characters, which are left to the caller
+		size_t prefix = table::count;
+		for(size_t i = 0; i < table::count; ++i)
+		{
+			if(text.named[i] && text.lengths[i] != 0 && text.lengths[i] < length &&
+				(prefix == table::count || text.lengths[i] > text.lengths[prefix]) &&
+				std::char_traits<CharT>::compare(text.characters + text.offsets[i], first, text.lengths[i]) == 0)
+			{
+				prefix = i;
+			}
+		}
+		if(prefix != table::count)
+		{
+			value = static_cast<Enum>(prefix);
+			return first + text.lengths[prefix];
+		}
+		value = Enum();
+		return begin;
+	}
+
+	template<typename Enum, typename StdStrType>
+	struct enum_string_converter : string_convertible
+	{
+		typedef StdStrType std_str_type;
+		typedef Enum value_type;
+		typedef typename StdStrType::value_type char_type;
+		static std_str_type to_string(const value_type& val)
+		{
+			std_str_type text;
+			append_executor<Enum>::append(text, val);
+			return text;
+		}
+		static const char_type* parse(const char_type* first, const char_type* last, value_type& value, bool& out_of_range)
+		{
+			return parse_enum(first, last, value, out_of_range);
+		}
+		static value_type get_value(const char_type* first, const char_type* last)
+		{
+			value_type value;
+			bool out_of_range;
+			parse(first, last, value, out_of_range);
+			return value;
+		}
+		static value_type get_value(const StdStrType& str)	{ return get_value(str.data(), str.data() + str.size()); }
+	};
+
+	// the name is copied from the table, and a value without a name is written as its integral value
+	template<typename Enum>
+	struct enum_append_executor
+	{
+		typedef enum_table<Enum> table;
+		typedef typename enum_number<Enum>::type number_type;
+
+		static size_t index_of(const Enum& from)
+		{
+			const size_t index = static_cast<size_t>(from);
+			return index < table::count && table::narrow.named[index] ? index : table::count;
+		}
+		template<typename StdStrType>
+		static void append(StdStrType& dst, const Enum& from)
+		{
+			const size_t index = index_of(from);
+			if(index == table::count)
+			{
+				append_format(dst, static_cast<number_type>(from));
+				return;
+			}
+			const auto& text = table::text(typename StdStrType::value_type());
+			dst.append(text.characters + text.offsets[index], text.lengths[index]);
+		}
+		template<typename CharT>
+		static CharT* write(CharT* first, CharT* last, const Enum& from)
+		{
+			const size_t index = index_of(from);
+			if(index == table::count)
+			{
+				return write_format(first, last, static_cast<number_type>(from));
+			}
+			const auto& text = table::text(CharT());
+			if(static_cast<size_t>(last - first) < text.lengths[index])
+			{
+				return NULL;
+			}
+			return std::copy(text.characters + text.offsets[index], text.characters + text.offsets[index] + text.lengths[index], first);
+		}
+		template<typename CharT>
+		static size_t length_bound(const Enum& from)
+		{
+			const size_t index = index_of(from);
+			return index == table::count ? format_length_bound(static_cast<number_type>(from)) : table::narrow.lengths[index];
+		}
+	};
+}	// End Of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/**
+ * @brief   this macro registers the names of Enum, which intelligent_cast converts to and from
+ * @param   Enum	 enum type (or bool), qualified by its namespace
+ * @param   ...		 string literals of the names of the values 0, 1, 2 and so on, NULL for a value without a name
+ *
+ *   the macro must be used in the global namespace, once for each Enum.\n
+ *   the names are ASCII and distinct. a duplicated name is a compile error (enum_name_is_duplicated).
+ *
+ *   (example)
+ * @code
+	enum class color { red, green, blue };
+	INTELLIGENT_CAST_ENUM(color, "red", "green", "blue")
+
+	std::string a = intelligent_cast<std::string>(color::green);	// "green"
+	color b = intelligent_cast<color>(L"blue");						// color::blue
+ * @endcode
+ */
+//---------------------------------------------------------------------------
+#define INTELLIGENT_CAST_ENUM(Enum, ...) \
+	template<> \
+	struct intelligent_cast_enum_names<Enum> \
+	{ \
+		static constexpr auto list() \
+		{ \
+			const char* const names[] = { __VA_ARGS__ }; \
+			return intelligent_cast_detail::make_enum_name_list(names); \
+		} \
+	}; \
+	namespace intelligent_cast_detail \
+	{ \
+		template<typename StdStrType> \
+		struct string_converter<Enum, StdStrType> : enum_string_converter<Enum, StdStrType> \
+		{ \
+		}; \
+		template<> \
+		struct append_executor<Enum, numeric_type> : enum_append_executor<Enum> \
+		{ \
+		}; \
+		template<> \
+		struct is_appendable<Enum> : std::true_type \
+		{ \
+		}; \
+	}
+
+// bool is converted to and from "false" and "true"
+INTELLIGENT_CAST_ENUM(bool, "false", "true")
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   name of registered value
+ * @param[in] value value of Enum registered by INTELLIGENT_CAST_ENUM
+ * @returns NUL terminated name of CharT in static storage, or NULL if value has no name
+ */
+//---------------------------------------------------------------------------
+template<typename CharT = char, typename Enum>
+inline const CharT* intelligent_cast_enum_name(Enum value)
+{
+	using namespace intelligent_cast_detail;
+	const size_t index = enum_append_executor<Enum>::index_of(value);
+	if(index == enum_table<Enum>::count)
+	{
+		return NULL;
+	}
+	const auto& text = enum_table<Enum>::text(CharT());
+	return text.characters + text.offsets[index];
+}
@@ -0,0 +1,626 @@
+#pragma once
+#include <string>
+#include <limits>
+#include <type_traits>
+#include "IntelligentCast.h"
+
+namespace intelligent_cast_fmt
+{
+	/** base of format policies, which tells intelligent_cast that the second template argument is a policy */
+	struct format_policy{};
+}	// End Of Namespace intelligent_cast_fmt
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief check whether a type is a format policy
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	struct is_format_policy : std::is_base_of<intelligent_cast_fmt::format_policy, T>
+	{
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief stored bits of floating point value
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	struct floating_bits
+	{
+		typedef floating_traits<T> traits;
+		typedef typename traits::carrier_type carrier_type;
+
+		explicit floating_bits(T value)
+		{
+			carrier_type bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			significand = bits & ((static_cast<carrier_type>(1) << traits::significand_bits) - 1);
+			exponent = static_cast<int>((bits >> traits::significand_bits) & ((1u << traits::exponent_bits) - 1));
+			negative = (bits >> (traits::significand_bits + traits::exponent_bits)) != 0;
+		}
+		bool is_finite() const	{ return exponent != (1 << traits::exponent_bits) - 1; }
+		bool is_zero() const	{ return exponent == 0 && significand == 0; }
+		/** exponent of the unit in the last place */
+		int ulp_exponent() const	{ return (exponent == 0 ? 1 : exponent) - traits::exponent_bias - traits::significand_bits; }
+
+		carrier_type significand;
+		int exponent;
+		bool negative;
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write non finite value in the same way as write_floating
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	inline CharT* write_non_finite(CharT* out, const floating_bits<T>& bits)
+	{
+		if(bits.significand != 0)
+		{
+			return write_literal(out, "nan");
+		}
+		return write_literal(out, bits.negative ? "-inf" : "inf");
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief set long decimal to unsigned value
+	 */
+	//---------------------------------------------------------------------------
+	inline void assign_decimal(long_decimal& d, unsigned long long value, int exponent)
+	{
+		char digits[20];
+		const int count = count_digits(value);
+		write_digits(digits + count, value);
+		d.num_digits = count;
+		d.decimal_point = count + exponent;
+		d.truncated = false;
+		for(int i = 0; i < count; ++i)
+		{
+			d.digits[i] = static_cast<unsigned char>(digits[i] - '0');
+		}
+		trim(d);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief exact decimal of finite non zero floating point value
+	 *
+	 *	the binary significand is shifted by its exponent in long decimal.
+	 *	the exact decimal of double has at most 767 significant digits, so no digit is dropped.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	inline void exact_decimal(long_decimal& d, const floating_bits<T>& bits)
+	{
+		const int max_shift = 60;
+		const unsigned long long hidden = bits.exponent == 0 ? 0 : 1ULL << floating_traits<T>::significand_bits;
+		assign_decimal(d, bits.significand | hidden, 0);
+		for(int exponent = bits.ulp_exponent(); exponent != 0; )
+		{
+			if(exponent > 0)
+			{
+				const int shift = exponent < max_shift ? exponent : max_shift;
+				left_shift(d, shift);
+				exponent -= shift;
+			}
+			else
+			{
+				const int shift = -exponent < max_shift ? -exponent : max_shift;
+				right_shift(d, shift);
+				exponent += shift;
+			}
+		}
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief check whether rounding long decimal to keep digits is a tie
+	 */
+	//---------------------------------------------------------------------------
+	inline bool is_rounding_tie(const long_decimal& d, int keep)
+	{
+		return keep >= 0 && keep + 1 == d.num_digits && d.digits[keep] == 5 && !d.truncated;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief round long decimal to nearest even at keep digits
+	 * @param[in,out]	d : long decimal
+	 * @param[in]	keep : the number of significant digits kept, which may be zero or negative
+	 */
+	//---------------------------------------------------------------------------
+	inline void round_decimal(long_decimal& d, int keep)
+	{
+		if(keep >= d.num_digits)
+		{
+			return;
+		}
+		if(keep < 0)
+		{
+			d.num_digits = 0;
+			return;
+		}
+		bool round_up = d.digits[keep] >= 5;
+		if(is_rounding_tie(d, keep))
+		{
+			round_up = keep > 0 && (d.digits[keep - 1] & 1) != 0;
+		}
+		d.num_digits = keep;
+		if(round_up)
+		{
+			int i = keep - 1;
+			while(i >= 0 && d.digits[i] == 9)
+			{
+				--i;
+			}
+			if(i < 0)
+			{
+				// 999 is rounded up to 1000
+				d.digits[0] = 1;
+				d.num_digits = 1;
+				++d.decimal_point;
+			}
+			else
+			{
+				++d.digits[i];
+				d.num_digits = i + 1;
+			}
+		}
+		trim(d);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief check whether 2^binary_exponent is less than 10^decimal_exponent
+	 *
+	 *	log2(10) is approximated to the safe side, so it may be false for a few exponents near the boundary.
+	 */
+	//---------------------------------------------------------------------------
+	inline bool is_below_decimal_unit(int binary_exponent, int decimal_exponent)
+	{
+		return binary_exponent * 1000 < decimal_exponent * (decimal_exponent < 0 ? 3322 : 3321);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief decimal of floating point value rounded in the same way as printf
+	 * @param[out]	d : correctly rounded decimal
+	 * @param[in]	bits : finite non zero value
+	 * @param[in]	keep : function which returns the number of digits kept for decimal point
+	 * @param[in]	unit : function which returns the exponent of the last digit kept for decimal point
+	 *
+	 *	the shortest decimal is rounded when it is known to give the same digits as the exact value,
+	 *	that is, when its dropped digits are not a tie, or when the unit in the last place of the value is
+	 *	smaller than the last digit kept. otherwise the exact decimal is rounded.\n
+	 *	a shortest decimal of a single 1 is a power of ten, and the exact value may be just below it with one digit less
+	 *	before the decimal point (1e23 is 9.999...e22), so the exact decimal is always rounded for it.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T, typename Keep, typename Unit>
+	inline void rounded_decimal(long_decimal& d, const floating_bits<T>& bits, Keep keep, Unit unit)
+	{
+		const shortest_decimal<T> shortest = to_shortest_decimal<T>(bits.significand, bits.exponent);
+		assign_decimal(d, shortest.significand, shortest.exponent);
+		const int shortest_keep = keep(d.decimal_point);
+		const bool power_of_ten = d.num_digits == 1 && d.digits[0] == 1;
+		if(!power_of_ten &&
+			(shortest_keep < d.num_digits ? !is_rounding_tie(d, shortest_keep) : is_below_decimal_unit(bits.ulp_exponent(), unit(d.decimal_point))))
+		{
+			round_decimal(d, shortest_keep);
+			return;
+		}
+		exact_decimal(d, bits);
+		round_decimal(d, keep(d.decimal_point));
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief digit of long decimal at position, which is 0 outside of the digits
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	inline CharT decimal_digit(const long_decimal& d, int position)
+	{
+		return static_cast<CharT>('0' + (position >= 0 && position < d.num_digits ? d.digits[position] : 0));
+	}
+
+	struct fixed_keep
+	{
+		int precision;
+		int operator()(int decimal_point) const	{ return decimal_point + precision; }
+	};
+	struct fixed_unit
+	{
+		int precision;
+		int operator()(int) const				{ return -precision; }
+	};
+	struct scientific_keep
+	{
+		int precision;
+		int operator()(int) const				{ return precision + 1; }
+	};
+	struct scientific_unit
+	{
+		int precision;
+		int operator()(int decimal_point) const	{ return decimal_point - 1 - precision; }
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write floating point value in the same way as printf "%.*f"
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	inline CharT* write_fixed(CharT* out, T value, int precision)
+	{
+		const floating_bits<T> bits(value);
+		if(!bits.is_finite())
+		{
+			return write_non_finite(out, bits);
+		}
+		long_decimal d;
+		d.num_digits = 0;
+		d.decimal_point = 0;
+		if(!bits.is_zero())
+		{
+			const fixed_keep keep = { precision };
+			const fixed_unit unit = { precision };
+			rounded_decimal(d, bits, keep, unit);
+		}
+		if(bits.negative)
+		{
+			*out++ = static_cast<CharT>('-');
+		}
+		if(d.num_digits == 0 || d.decimal_point <= 0)
+		{
+			*out++ = static_cast<CharT>('0');
+		}
+		for(int i = 0; i < d.decimal_point; ++i)
+		{
+			*out++ = decimal_digit<CharT>(d, i);
+		}
+		if(precision > 0)
+		{
+			*out++ = static_cast<CharT>('.');
+			for(int i = 0; i < precision; ++i)
+			{
+				*out++ = decimal_digit<CharT>(d, d.decimal_point + i);
+			}
+		}
+		return out;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write floating point value in the same way as printf "%.*e"
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	inline CharT* write_scientific(CharT* out, T value, int precision)
+	{
+		const floating_bits<T> bits(value);
+		if(!bits.is_finite())
+		{
+			return write_non_finite(out, bits);
+		}
+		long_decimal d;
+		d.num_digits = 0;
+		d.decimal_point = 1;
+		if(!bits.is_zero())
+		{
+			const scientific_keep keep = { precision };
+			const scientific_unit unit = { precision };
+			rounded_decimal(d, bits, keep, unit);
+		}
+		if(bits.negative)
+		{
+			*out++ = static_cast<CharT>('-');
+		}
+		*out++ = decimal_digit<CharT>(d, 0);
+		if(precision > 0)
+		{
+			*out++ = static_cast<CharT>('.');
+			for(int i = 1; i <= precision; ++i)
+			{
+				*out++ = decimal_digit<CharT>(d, i);
+			}
+		}
+		const int exponent = d.decimal_point - 1;
+		*out++ = static_cast<CharT>('e');
+		*out++ = static_cast<CharT>(exponent < 0 ? '-' : '+');
+		const unsigned int exponent_magnitude = static_cast<unsigned int>(exponent < 0 ? -exponent : exponent);
+		if(exponent_magnitude < 10)
+		{
+			*out++ = static_cast<CharT>('0');
+		}
+		const int exponent_digits = count_digits(exponent_magnitude);
+		write_digits(out + exponent_digits, exponent_magnitude);
+		return out + exponent_digits;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief write integral value in hexadecimal in the same way as printf "%x"
+	 *
+	 *	negative value is written as its unsigned representation of the same width.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	inline CharT* write_hex(CharT* out, T value, const char* digits)
+	{
+		typedef typename unsigned_digits_type<T>::unsigned_type unsigned_type;
+		unsigned_type magnitude = static_cast<unsigned_type>(value);
+		int count = 1;
+		for(unsigned_type rest = static_cast<unsigned_type>(magnitude >> 4); rest != 0; rest = static_cast<unsigned_type>(rest >> 4))
+		{
+			++count;
+		}
+		for(int i = count - 1; i >= 0; --i)
+		{
+			out[i] = static_cast<CharT>(digits[magnitude & 0xF]);
+			magnitude = static_cast<unsigned_type>(magnitude >> 4);
+		}
+		return out + count;
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief build result string of format policy from characters
+	 */
+	//---------------------------------------------------------------------------
+	template<typename To>
+	struct format_reduction
+	{
+		typedef typename type_traits<To>::std_str_converter std_str_converter;
+		typedef typename std_str_converter::handle_type handle_type;
+		typedef typename handle_type::value_type char_type;
+		static To reduction(const char_type* first, const char_type* last)
+		{
+			static_assert(!std::is_pointer<To>::value, "format policy can not convert to pointer. use std::string or std::wstring.");
+			return std_str_converter::reduction(handle_type(first, last));
+		}
+	};
+	template<typename CharT, typename Traits, typename Alloc>
+	struct format_reduction<std::basic_string<CharT, Traits, Alloc> >
+	{
+		typedef CharT char_type;
+		static std::basic_string<CharT, Traits, Alloc> reduction(const CharT* first, const CharT* last)
+		{
+			return std::basic_string<CharT, Traits, Alloc>(first, last);
+		}
+	};
+	template<size_t N, typename CharT>
+	struct format_reduction<inline_string<N, CharT> >
+	{
+		typedef CharT char_type;
+		static inline_string<N, CharT> reduction(const CharT* first, const CharT* last)
+		{
+			return inline_string<N, CharT>(first, last);
+		}
+	};
+}	// End Of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+// format policies, which are given to intelligent_cast, intelligent_cast_append and intelligent_cast_to.
+// each policy has max_length<T>::value, the maximum number of characters written for T,
+// and write(out, value) which writes the text from out and returns one past the last character.
+//---------------------------------------------------------------------------
+namespace intelligent_cast_fmt
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief the same text as intelligent_cast (decimal integer, or the shortest floating point value)
+	 */
+	//---------------------------------------------------------------------------
+	struct dec : format_policy
+	{
+		template<typename T>
+		struct max_length
+		{
+			static const size_t value = intelligent_cast_detail::max_format_length<T>::value;
+		};
+		template<typename CharT, typename T>
+		static typename std::enable_if<std::is_integral<T>::value, CharT*>::type write(CharT* out, const T& value)
+		{
+			const intelligent_cast_detail::integral_magnitude<T> digits(value);
+			digits.write(out);
+			return out + digits.length;
+		}
+		template<typename CharT, typename T>
+		static typename std::enable_if<std::is_floating_point<T>::value, CharT*>::type write(CharT* out, const T& value)
+		{
+			return intelligent_cast_detail::write_floating(out, value);
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief hexadecimal integer in lower case, same as printf "%x"
+	 */
+	//---------------------------------------------------------------------------
+	struct hex : format_policy
+	{
+		template<typename T>
+		struct max_length
+		{
+			static_assert(std::is_integral<T>::value, "hex is supported only for integral type.");
+			static const size_t value = sizeof(T) * 2;
+		};
+		template<typename CharT, typename T>
+		static CharT* write(CharT* out, const T& value)
+		{
+			return intelligent_cast_detail::write_hex(out, value, "0123456789abcdef");
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief hexadecimal integer in upper case, same as printf "%X"
+	 */
+	//---------------------------------------------------------------------------
+	struct upper_hex : format_policy
+	{
+		template<typename T>
+		struct max_length
+		{
+			static_assert(std::is_integral<T>::value, "upper_hex is supported only for integral type.");
+			static const size_t value = sizeof(T) * 2;
+		};
+		template<typename CharT, typename T>
+		static CharT* write(CharT* out, const T& value)
+		{
+			return intelligent_cast_detail::write_hex(out, value, "0123456789ABCDEF");
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief floating point value with Precision digits after the point, same as printf "%.<Precision>f"
+	 */
+	//---------------------------------------------------------------------------
+	template<int Precision>
+	struct fixed : format_policy
+	{
+		static_assert(Precision >= 0, "Precision must not be negative.");
+		template<typename T>
+		struct max_length
+		{
+			static_assert(std::is_floating_point<T>::value, "fixed is supported only for floating point type.");
+			// sign, integer digits, point and fraction digits
+			static const size_t value = 1 + (std::numeric_limits<T>::max_exponent10 + 1) + 1 + Precision;
+		};
+		template<typename CharT, typename T>
+		static CharT* write(CharT* out, const T& value)
+		{
+			return intelligent_cast_detail::write_fixed(out, value, Precision);
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief floating point value with Precision digits after the point and exponent, same as printf "%.<Precision>e"
+	 */
+	//---------------------------------------------------------------------------
+	template<int Precision>
+	struct scientific : format_policy
+	{
+		static_assert(Precision >= 0, "Precision must not be negative.");
+		template<typename T>
+		struct max_length
+		{
+			static_assert(std::is_floating_point<T>::value, "scientific is supported only for floating point type.");
+			// sign, digit, point, fraction digits, and exponent such as "e-308"
+			static const size_t value = 1 + 1 + 1 + Precision + 5;
+		};
+		template<typename CharT, typename T>
+		static CharT* write(CharT* out, const T& value)
+		{
+			return intelligent_cast_detail::write_scientific(out, value, Precision);
+		}
+	};
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief text of Format padded with zeros after the sign to Width characters, same as printf "%0<Width>d"
+	 *
+	 *	non finite value is padded with spaces before it.
+	 */
+	//---------------------------------------------------------------------------
+	template<int Width, typename Format = dec>
+	struct zero_pad : format_policy
+	{
+		static_assert(Width >= 0, "Width must not be negative.");
+		template<typename T>
+		struct max_length
+		{
+			static const size_t value = static_cast<size_t>(Width) > Format::template max_length<T>::value ?
+				static_cast<size_t>(Width) : Format::template max_length<T>::value;
+		};
+		template<typename CharT, typename T>
+		static CharT* write(CharT* out, const T& value)
+		{
+			CharT* const last = Format::write(out, value);
+			const int length = static_cast<int>(last - out);
+			if(length >= Width)
+			{
+				return last;
+			}
+			const int padding = Width - length;
+			// "inf" and "nan" are the only texts which do not start with a digit after the sign
+			CharT* digits = out;
+			CharT fill = static_cast<CharT>('0');
+			if(*digits == static_cast<CharT>('-') || *digits == static_cast<CharT>('+'))
+			{
+				++digits;
+			}
+			if(digits != last && (*digits == static_cast<CharT>('i') || *digits == static_cast<CharT>('n')))
+			{
+				digits = out;
+				fill = static_cast<CharT>(' ');
+			}
+			std::char_traits<CharT>::move(digits + padding, digits, static_cast<size_t>(last - digits));
+			std::char_traits<CharT>::assign(digits, static_cast<size_t>(padding), fill);
+			return out + Width;
+		}
+	};
+}	// End Of Namespace intelligent_cast_fmt
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   intelligent cast with format policy
+ * @param[in] from numeric value
+ * @returns string of To type formatted by Format
+ *
+ * Format is a policy in intelligent_cast_fmt, such as intelligent_cast<std::string, intelligent_cast_fmt::hex>(255).
+ * the policy is resolved at compile time, no format string is parsed at runtime.
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename Format, typename From>
+typename std::enable_if<intelligent_cast_detail::is_format_policy<Format>::value, To>::type
+intelligent_cast(const From& from)
+{
+	using namespace intelligent_cast_detail;
+	static_assert(std::is_arithmetic<From>::value, "format policy is supported only for numeric value.");
+	typedef typename format_reduction<To>::char_type char_type;
+	char_type buf[Format::template max_length<From>::value];
+	return format_reduction<To>::reduction(buf, Format::write(buf, from));
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   append text formatted by format policy to string
+ * @param[in,out] dst std::basic_string of char or wchar_t with any allocator, which is appended to
+ * @param[in] from numeric value
+ * @returns dst
+ */
+//---------------------------------------------------------------------------
+template<typename Format, typename CharT, typename From, typename Traits, typename Alloc>
+typename std::enable_if<intelligent_cast_detail::is_format_policy<Format>::value, std::basic_string<CharT, Traits, Alloc>&>::type
+intelligent_cast_append(std::basic_string<CharT, Traits, Alloc>& dst, const From& from)
+{
+	static_assert(std::is_arithmetic<From>::value, "format policy is supported only for numeric value.");
+	CharT buf[Format::template max_length<From>::value];
+	dst.append(buf, Format::write(buf, from));
+	return dst;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   write text formatted by format policy to buffer
+ * @param[in] first first character of buffer
+ * @param[in] last one past the last character of buffer
+ * @param[in] from numeric value
+ * @returns the end of written text, or buffer_too_small error
+ *
+ * the text is written directly when the buffer has room for Format::max_length, otherwise through a temporary buffer.
+ */
+//---------------------------------------------------------------------------
+template<typename Format, typename CharT, typename From>
+typename std::enable_if<intelligent_cast_detail::is_format_policy<Format>::value, intelligent_cast_to_result<CharT> >::type
+intelligent_cast_to(CharT* first, CharT* last, const From& from)
+{
+	static_assert(std::is_arithmetic<From>::value, "format policy is supported only for numeric value.");
+	const size_t max_length = Format::template max_length<From>::value;
+	intelligent_cast_to_result<CharT> result = { last, intelligent_cast_errc::ok };
+	if(static_cast<size_t>(last - first) >= max_length)
+	{
+		result.ptr = Format::write(first, from);
+		return result;
+	}
+	CharT buf[max_length];
+	const CharT* const end = Format::write(buf, from);
+	if(last - first < end - buf)
+	{
+		result.error = intelligent_cast_errc::buffer_too_small;
+		return result;
+	}
+	result.ptr = std::copy(static_cast<const CharT*>(buf), end, first);
+	return result;
+}
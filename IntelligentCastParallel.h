@@ -0,0 +1,521 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "IntelligentCast.h"
+#include "IntelligentCastBatch.h"
+
+//---------------------------------------------------------------------------
+/**
+ * @brief thread pool which runs the iterations of a loop with work stealing
+ *
+ *	the iterations are divided evenly among the workers and the calling thread at first,
+ *	and a participant which finished its own share steals the upper half of the share of another.
+ *	each share is one atomic pair of indices, so no lock is taken while the loop runs.\n
+ *	parallel_for called from an iteration runs serially in the calling thread.
+ */
+//---------------------------------------------------------------------------
+class intelligent_cast_thread_pool
+{
+public:
+	/** threads is the number of participants including the calling thread, all hardware threads by default */
+	explicit intelligent_cast_thread_pool(unsigned int threads = std::thread::hardware_concurrency())
+		: slots_(new slot[threads ? threads : 1])
+		, generation_(0)
+		, active_(0)
+		, stop_(false)
+		, invoke_(NULL)
+		, context_(NULL)
+	{
+		for(unsigned int i = 1; i < threads; ++i)
+		{
+			workers_.push_back(std::thread(&intelligent_cast_thread_pool::work, this, static_cast<size_t>(i)));
+		}
+	}
+	~intelligent_cast_thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		for(size_t i = 0; i < workers_.size(); ++i)
+		{
+			workers_[i].join();
+		}
+	}
+
+	/** the number of participants including the calling thread */
+	size_t size() const		{ return workers_.size() + 1; }
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief call func(i) for each i in [0, count) in parallel, and return after all calls return
+	 *
+	 *	an exception thrown by func is rethrown here after the other iterations finish.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename Func>
+	void parallel_for(size_t count, Func& func)
+	{
+		if(workers_.empty() || count < 2 || inside())
+		{
+			for(size_t i = 0; i < count; ++i)
+			{
+				func(i);
+			}
+			return;
+		}
+		std::lock_guard<std::mutex> job(job_mutex_);
+		// a share is two 32 bit indices, so a long loop is run in slices
+		const size_t max_slice = 0xFFFFFFFFu;
+		for(size_t base = 0; base < count; base += max_slice)
+		{
+			const size_t slice = (std::min)(count - base, max_slice);
+			const size_t participants = size();
+			for(size_t s = 0; s < participants; ++s)
+			{
+				slots_[s].share.store(pack(slice * s / participants, slice * (s + 1) / participants), std::memory_order_relaxed);
+			}
+			sliced_loop<Func> loop = { &func, base };
+			invoke_ = &sliced_loop<Func>::invoke;
+			context_ = &loop;
+			error_ = std::exception_ptr();
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				active_ = workers_.size();
+				++generation_;
+			}
+			wake_.notify_all();
+			run(0);
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				while(active_ != 0)
+				{
+					done_.wait(lock);
+				}
+			}
+			if(error_)
+			{
+				std::rethrow_exception(error_);
+			}
+		}
+	}
+
+	/** pool shared by the bulk conversions, which has all hardware threads */
+	static intelligent_cast_thread_pool& shared()
+	{
+		static intelligent_cast_thread_pool pool;
+		return pool;
+	}
+
+private:
+	intelligent_cast_thread_pool(const intelligent_cast_thread_pool&);
+	intelligent_cast_thread_pool& operator=(const intelligent_cast_thread_pool&);
+
+	// share of a participant [first, last), padded to a cache line so that the owners do not share a line
+	struct slot
+	{
+		std::atomic<unsigned long long> share;
+		char padding[64 - sizeof(std::atomic<unsigned long long>)];
+	};
+	template<typename Func>
+	struct sliced_loop
+	{
+		Func* func;
+		size_t base;
+		static void invoke(void* context, size_t index)
+		{
+			sliced_loop* const loop = static_cast<sliced_loop*>(context);
+			(*loop->func)(loop->base + index);
+		}
+	};
+
+	static unsigned long long pack(size_t first, size_t last)	{ return (static_cast<unsigned long long>(first) << 32) | last; }
+	static size_t first_of(unsigned long long share)			{ return static_cast<size_t>(share >> 32); }
+	static size_t last_of(unsigned long long share)				{ return static_cast<size_t>(share & 0xFFFFFFFFu); }
+
+	/** true while the current thread runs iterations */
+	static bool& inside()
+	{
+		static thread_local bool running = false;
+		return running;
+	}
+
+	// take the first index of own share, or steal the upper half of the share of another participant
+	bool next(size_t self, size_t& index)
+	{
+		slot& own = slots_[self];
+		unsigned long long share = own.share.load(std::memory_order_acquire);
+		while(first_of(share) < last_of(share))
+		{
+			if(own.share.compare_exchange_weak(share, pack(first_of(share) + 1, last_of(share)), std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				index = first_of(share);
+				return true;
+			}
+		}
+		const size_t participants = size();
+		for(size_t k = 1; k < participants; ++k)
+		{
+			slot& victim = slots_[(self + k) % participants];
+			share = victim.share.load(std::memory_order_acquire);
+			while(first_of(share) < last_of(share))
+			{
+				const size_t middle = first_of(share) + (last_of(share) - first_of(share)) / 2;
+				if(victim.share.compare_exchange_weak(share, pack(first_of(share), middle), std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					// own share is empty, so no thief changes it until this store
+					own.share.store(pack(middle + 1, last_of(share)), std::memory_order_release);
+					index = middle;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+	void run(size_t self)
+	{
+		inside() = true;
+		size_t index;
+		while(next(self, index))
+		{
+			try
+			{
+				invoke_(context_, index);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if(!error_)
+				{
+					error_ = std::current_exception();
+				}
+			}
+		}
+		inside() = false;
+	}
+	void work(size_t self)
+	{
+		unsigned long long generation = 0;
+		for(;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				while(!stop_ && generation_ == generation)
+				{
+					wake_.wait(lock);
+				}
+				if(stop_)
+				{
+					return;
+				}
+				generation = generation_;
+			}
+			run(self);
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if(--active_ == 0)
+				{
+					done_.notify_one();
+				}
+			}
+		}
+	}
+
+	std::vector<std::thread> workers_;
+	std::unique_ptr<slot[]> slots_;
+	std::mutex job_mutex_;
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable done_;
+	unsigned long long generation_;
+	size_t active_;
+	bool stop_;
+	void (*invoke_)(void*, size_t);
+	void* context_;
+	std::exception_ptr error_;
+};
+
+namespace intelligent_cast_detail
+{
+	/** characters of transcoding chunk, and values of formatting or parsing chunk */
+	const size_t parallel_transcode_chunk = 1 << 20;
+	const size_t parallel_column_chunk = 1 << 16;
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief move chunk boundary back to the start of a code point
+	 *
+	 *	UTF-8 continuation bytes (at most 3) and a low surrogate of UTF-16 are not split from their lead.
+	 *	an invalid sequence is not moved further, it stops the conversion in any chunk.
+	 */
+	//---------------------------------------------------------------------------
+	inline const char* code_point_boundary(const char* first, const char* p)
+	{
+		for(int i = 0; i < 3 && p != first && (static_cast<unsigned char>(*p) & 0xC0u) == 0x80u; ++i)
+		{
+			--p;
+		}
+		return p;
+	}
+	inline const wchar_t* code_point_boundary(const wchar_t* first, const wchar_t* p)
+	{
+		if(sizeof(wchar_t) == 2 && p != first && static_cast<unsigned int>(static_cast<unsigned short>(*p)) - 0xDC00u < 0x400u)
+		{
+			--p;
+		}
+		return p;
+	}
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief transcoding of one chunk, whose length is counted in the first pass and written in the second
+	 */
+	//---------------------------------------------------------------------------
+	template<typename OutCharT, typename CharT>
+	struct transcode_chunk
+	{
+		const CharT* first;
+		const CharT* last;
+		const CharT* valid_last;
+		size_t length;
+		size_t offset;
+	};
+	template<typename OutCharT, typename CharT>
+	struct transcode_length_pass
+	{
+		transcode_chunk<OutCharT, CharT>* chunks;
+		void operator()(size_t i)
+		{
+			chunks[i].length = transcoder<OutCharT, CharT>::length(chunks[i].first, chunks[i].last, chunks[i].valid_last);
+		}
+	};
+	template<typename OutCharT, typename CharT>
+	struct transcode_write_pass
+	{
+		transcode_chunk<OutCharT, CharT>* chunks;
+		OutCharT* out;
+		void operator()(size_t i)
+		{
+			transcoder<OutCharT, CharT>::write(chunks[i].first, chunks[i].valid_last, out + chunks[i].offset);
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief transcode character range in parallel
+	 *
+	 *	the range is split at code point boundaries, the length of each chunk is counted in parallel,
+	 *	and each chunk is written at its offset of the result, which is allocated once.
+	 *	like transcode, the result ends before the first invalid sequence.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename StdStrType, typename CharT>
+	inline StdStrType parallel_transcode(const CharT* first, const CharT* last, intelligent_cast_thread_pool& pool)
+	{
+		typedef typename StdStrType::value_type out_char_type;
+		const size_t size = static_cast<size_t>(last - first);
+		const size_t count = (size + parallel_transcode_chunk - 1) / parallel_transcode_chunk;
+		if(pool.size() == 1 || count < 2)
+		{
+			StdStrType result;
+			append_range(result, first, last);
+			return result;
+		}
+		std::vector<transcode_chunk<out_char_type, CharT> > chunks(count);
+		const CharT* chunk_first = first;
+		for(size_t i = 0; i < count; ++i)
+		{
+			chunks[i].first = chunk_first;
+			chunks[i].last = i + 1 == count ? last : code_point_boundary(chunk_first, first + size / count * (i + 1));
+			chunk_first = chunks[i].last;
+		}
+		transcode_length_pass<out_char_type, CharT> length_pass = { &chunks[0] };
+		pool.parallel_for(count, length_pass);
+
+		// chunks after the first invalid sequence are dropped
+		size_t used = 0;
+		size_t length = 0;
+		while(used < count)
+		{
+			transcode_chunk<out_char_type, CharT>& chunk = chunks[used++];
+			chunk.offset = length;
+			length += chunk.length;
+			if(chunk.valid_last != chunk.last)
+			{
+				break;
+			}
+		}
+		StdStrType result(length, out_char_type());
+		if(length != 0)
+		{
+			transcode_write_pass<out_char_type, CharT> write_pass = { &chunks[0], &result[0] };
+			pool.parallel_for(used, write_pass);
+		}
+		return result;
+	}
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief formatting of a column in chunks
+	 *
+	 *	each chunk is formatted into its own buffer with offsets relative to the buffer in the first pass,
+	 *	and copied to the result with the offsets moved in the second pass.
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT, typename T>
+	struct format_column_pass
+	{
+		const T* values;
+		size_t count;
+		size_t* offsets;
+		std::vector<std::basic_string<CharT> >* buffers;
+		void operator()(size_t i)
+		{
+			const size_t first = i * parallel_column_chunk;
+			const size_t last = (std::min)(first + parallel_column_chunk, count);
+			std::basic_string<CharT>& buffer = (*buffers)[i];
+			// the end offset of the chunk is the first offset of the next chunk, so it is kept aside
+			std::vector<size_t> chunk_offsets(last - first + 1);
+			intelligent_cast_format_batch(values + first, last - first, buffer, &chunk_offsets[0]);
+			std::copy(chunk_offsets.begin(), chunk_offsets.end() - 1, offsets + first);
+		}
+	};
+	template<typename CharT, typename T>
+	struct copy_column_pass
+	{
+		size_t count;
+		size_t* offsets;
+		const std::vector<std::basic_string<CharT> >* buffers;
+		const std::vector<size_t>* positions;
+		CharT* out;
+		void operator()(size_t i)
+		{
+			const size_t first = i * parallel_column_chunk;
+			const size_t last = (std::min)(first + parallel_column_chunk, count);
+			const std::basic_string<CharT>& buffer = (*buffers)[i];
+			const size_t position = (*positions)[i];
+			std::copy(buffer.begin(), buffer.end(), out + position);
+			for(size_t j = first; j < last; ++j)
+			{
+				offsets[j] += position;
+			}
+		}
+	};
+	template<typename T, typename CharT>
+	struct parse_column_pass
+	{
+		const CharT* text;
+		const size_t* offsets;
+		size_t count;
+		T* values;
+		std::vector<size_t>* errors;
+		void operator()(size_t i)
+		{
+			const size_t first = i * parallel_column_chunk;
+			const size_t last = (std::min)(first + parallel_column_chunk, count);
+			(*errors)[i] = intelligent_cast_parse_batch(text, offsets + first, last - first, values + first);
+		}
+	};
+}	// End Of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   convert string to another type of string in parallel
+ * @param[in] from std::string, std::wstring or any string type which intelligent_cast accepts
+ * @param[in,out] pool thread pool which converts the chunks
+ * @returns std::basic_string of To type, which is the same as intelligent_cast<To>(from)
+ *
+ * the input is split into chunks of 1M characters at code point boundaries. a short input is converted in the calling thread.
+ */
+//---------------------------------------------------------------------------
+template<typename To, typename From>
+typename std::enable_if<intelligent_cast_detail::is_basic_string<To>::value, To>::type
+intelligent_cast_parallel(const From& from, intelligent_cast_thread_pool& pool = intelligent_cast_thread_pool::shared())
+{
+	using namespace intelligent_cast_detail;
+	static_assert(std::is_same<typename type_traits<From>::type_info, string_type>::value, "parallel conversion is only supported for string. check From type.");
+	const typename type_traits<From>::std_str_converter::range_type range = type_traits<From>::std_str_converter::range(from);
+	return parallel_transcode<To>(range.first, range.second, pool);
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   convert array of numeric values to packed text in parallel
+ * @param[in] values numeric values
+ * @param[in] count the number of values
+ * @param[in,out] text std::string or std::wstring which the text of each value is appended to, without delimiter
+ * @param[out] offsets count + 1 positions in text, the i-th value is [offsets[i], offsets[i + 1])
+ * @param[in,out] pool thread pool which formats the chunks
+ *
+ * the result is the same as intelligent_cast_format_batch. chunks of 64K values are formatted into their own buffers in parallel,
+ * then copied to text, which is reallocated at most once, in parallel.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT, typename T>
+void intelligent_cast_format_parallel(const T* values, size_t count, std::basic_string<CharT>& text, size_t* offsets,
+	intelligent_cast_thread_pool& pool = intelligent_cast_thread_pool::shared())
+{
+	using namespace intelligent_cast_detail;
+	const size_t chunks = (count + parallel_column_chunk - 1) / parallel_column_chunk;
+	if(pool.size() == 1 || chunks < 2)
+	{
+		intelligent_cast_format_batch(values, count, text, offsets);
+		return;
+	}
+	std::vector<std::basic_string<CharT> > buffers(chunks);
+	format_column_pass<CharT, T> format_pass = { values, count, offsets, &buffers };
+	pool.parallel_for(chunks, format_pass);
+
+	std::vector<size_t> positions(chunks);
+	size_t position = text.size();
+	for(size_t i = 0; i < chunks; ++i)
+	{
+		positions[i] = position;
+		position += buffers[i].size();
+	}
+	text.resize(position);
+	offsets[count] = position;
+	copy_column_pass<CharT, T> copy_pass = { count, offsets, &buffers, &positions, &text[0] };
+	pool.parallel_for(chunks, copy_pass);
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   parse packed text fields into array of numeric values in parallel
+ * @param[in] text characters of all fields
+ * @param[in] offsets count + 1 positions in text, the i-th field is [offsets[i], offsets[i + 1])
+ * @param[in] count the number of fields
+ * @param[out] values parsed values, with the same value as intelligent_cast for invalid fields
+ * @param[in,out] pool thread pool which parses the chunks
+ * @returns the number of fields which are not entirely a number in range
+ *
+ * the result is the same as intelligent_cast_parse_batch. chunks of 64K fields are parsed in parallel.
+ */
+//---------------------------------------------------------------------------
+template<typename T, typename CharT>
+size_t intelligent_cast_parse_parallel(const CharT* text, const size_t* offsets, size_t count, T* values,
+	intelligent_cast_thread_pool& pool = intelligent_cast_thread_pool::shared())
+{
+	using namespace intelligent_cast_detail;
+	const size_t chunks = (count + parallel_column_chunk - 1) / parallel_column_chunk;
+	if(pool.size() == 1 || chunks < 2)
+	{
+		return intelligent_cast_parse_batch(text, offsets, count, values);
+	}
+	std::vector<size_t> errors(chunks);
+	parse_column_pass<T, CharT> parse_pass = { text, offsets, count, values, &errors };
+	pool.parallel_for(chunks, parse_pass);
+	size_t total = 0;
+	for(size_t i = 0; i < chunks; ++i)
+	{
+		total += errors[i];
+	}
+	return total;
+}
@@ -0,0 +1,351 @@
+#pragma once
+#include <istream>
+#include <string>
+#include <vector>
+#include <utility>
+#include "IntelligentCast.h"
+
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#define INTELLIGENT_CAST_UNDEF_NOMINMAX
+#endif
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#define INTELLIGENT_CAST_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#if defined(INTELLIGENT_CAST_UNDEF_NOMINMAX)
+#undef NOMINMAX
+#undef INTELLIGENT_CAST_UNDEF_NOMINMAX
+#endif
+#if defined(INTELLIGENT_CAST_UNDEF_WIN32_LEAN_AND_MEAN)
+#undef WIN32_LEAN_AND_MEAN
+#undef INTELLIGENT_CAST_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//---------------------------------------------------------------------------
+/**
+ * @brief read only memory mapping of whole file
+ *
+ *	the pages are loaded by the OS on demand, so the resident memory does not grow with the file size.
+ *	is_open() is false if the file can not be opened or mapped. an empty file is open with empty range.
+ */
+//---------------------------------------------------------------------------
+class intelligent_cast_mapped_file
+{
+public:
+	explicit intelligent_cast_mapped_file(const char* path)
+		: data_(NULL)
+		, size_(0)
+		, open_(false)
+	{
+#if defined(_WIN32)
+		const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if(file == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+		LARGE_INTEGER size;
+		if(GetFileSizeEx(file, &size) && static_cast<unsigned long long>(size.QuadPart) <= static_cast<size_t>(-1))
+		{
+			size_ = static_cast<size_t>(size.QuadPart);
+			open_ = size_ == 0;
+			if(size_ != 0)
+			{
+				// the view keeps the mapping alive after the handles are closed
+				const HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+				if(mapping != NULL)
+				{
+					data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+					open_ = data_ != NULL;
+					CloseHandle(mapping);
+				}
+			}
+		}
+		CloseHandle(file);
+#else
+		const int file = ::open(path, O_RDONLY);
+		if(file < 0)
+		{
+			return;
+		}
+		struct stat status;
+		if(::fstat(file, &status) == 0)
+		{
+			size_ = static_cast<size_t>(status.st_size);
+			open_ = size_ == 0;
+			if(size_ != 0)
+			{
+				void* const data = ::mmap(NULL, size_, PROT_READ, MAP_PRIVATE, file, 0);
+				if(data != MAP_FAILED)
+				{
+					::madvise(data, size_, MADV_SEQUENTIAL);
+					data_ = static_cast<const char*>(data);
+					open_ = true;
+				}
+			}
+		}
+		::close(file);
+#endif
+		if(!open_)
+		{
+			size_ = 0;
+		}
+	}
+	~intelligent_cast_mapped_file()
+	{
+		if(data_)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(data_);
+#else
+			::munmap(const_cast<char*>(data_), size_);
+#endif
+		}
+	}
+
+	bool is_open() const		{ return open_; }
+	const char* begin() const	{ return data_; }
+	const char* end() const		{ return data_ + size_; }
+	size_t size() const			{ return size_; }
+
+private:
+	intelligent_cast_mapped_file(const intelligent_cast_mapped_file&);
+	intelligent_cast_mapped_file& operator=(const intelligent_cast_mapped_file&);
+
+	const char* data_;
+	size_t size_;
+	bool open_;
+};
+
+//---------------------------------------------------------------------------
+/**
+ * @brief reader of delimited records of numeric fields
+ * @param CharT character type of input
+ *
+ *	the input is a character range (such as intelligent_cast_mapped_file) or std::basic_istream read in chunks.\n
+ *	fields are referred in the input buffer, and parsed in place by the string_converter of each type,
+ *	so no field is copied into string. the field ranges are valid until the next call of next().\n
+ *	a stream is buffered chunk_size characters at a time. the buffer grows only when one record is longer than it,
+ *	so memory use is bounded by the longest record, not by the size of input.\n
+ *	when record delimiter is '\\n', '\\r' before it is removed, and the last record need not end with the delimiter.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT = char>
+class intelligent_cast_reader
+{
+public:
+	typedef std::pair<const CharT*, const CharT*> range_type;
+
+	intelligent_cast_reader(const CharT* first, const CharT* last,
+		CharT field_delimiter = static_cast<CharT>(','), CharT record_delimiter = static_cast<CharT>('\n'))
+		: stream_(NULL)
+		, cursor_(first)
+		, last_(last)
+		, field_delimiter_(field_delimiter)
+		, record_delimiter_(record_delimiter)
+		, record_number_(0)
+	{
+	}
+	explicit intelligent_cast_reader(std::basic_istream<CharT>& stream,
+		CharT field_delimiter = static_cast<CharT>(','), CharT record_delimiter = static_cast<CharT>('\n'),
+		size_t chunk_size = 65536)
+		: stream_(&stream)
+		, buffer_(chunk_size ? chunk_size : 1)
+		, cursor_(NULL)
+		, last_(NULL)
+		, field_delimiter_(field_delimiter)
+		, record_delimiter_(record_delimiter)
+		, record_number_(0)
+	{
+	}
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief move to the next record
+	 * @return false if no record remains
+	 */
+	//---------------------------------------------------------------------------
+	bool next()
+	{
+		typedef std::char_traits<CharT> traits;
+		// characters already searched are not searched again after the buffer is refilled
+		size_t searched = 0;
+		const CharT* record_last;
+		for(;;)
+		{
+			record_last = traits::find(cursor_ + searched, static_cast<size_t>(last_ - cursor_) - searched, record_delimiter_);
+			if(record_last)
+			{
+				break;
+			}
+			searched = static_cast<size_t>(last_ - cursor_);
+			if(!fill())
+			{
+				break;
+			}
+		}
+		const CharT* const record_first = cursor_;
+		if(record_last)
+		{
+			cursor_ = record_last + 1;
+		}
+		else
+		{
+			if(cursor_ == last_)
+			{
+				fields_.clear();
+				return false;
+			}
+			record_last = last_;
+			cursor_ = last_;
+		}
+		if(record_delimiter_ == static_cast<CharT>('\n') && record_last != record_first && record_last[-1] == static_cast<CharT>('\r'))
+		{
+			--record_last;
+		}
+		split(record_first, record_last);
+		++record_number_;
+		return true;
+	}
+
+	/** the number of fields of the current record */
+	size_t size() const						{ return fields_.size(); }
+	/** 1-based number of the current record */
+	size_t record_number() const			{ return record_number_; }
+	/** characters of the field, which is not terminated by NUL */
+	range_type field(size_t index) const	{ return fields_[index]; }
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief parse field
+	 * @return value parsed in the same way as intelligent_cast, or 0 if the record has no such field
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	T get(size_t index) const
+	{
+		using namespace intelligent_cast_detail;
+		if(index >= fields_.size())
+		{
+			return T();
+		}
+		return string_converter<T, std::basic_string<CharT> >::get_value(fields_[index].first, fields_[index].second);
+	}
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief parse field which reports error
+	 * @return the same result as try_intelligent_cast, or invalid_argument if the record has no such field
+	 */
+	//---------------------------------------------------------------------------
+	template<typename T>
+	intelligent_cast_result<T> try_get(size_t index) const
+	{
+		if(index >= fields_.size())
+		{
+			const intelligent_cast_result<T> missing = { T(), intelligent_cast_errc::invalid_argument, 0 };
+			return missing;
+		}
+		return try_intelligent_cast<T>(fields_[index].first, fields_[index].second);
+	}
+
+private:
+	intelligent_cast_reader(const intelligent_cast_reader&);
+	intelligent_cast_reader& operator=(const intelligent_cast_reader&);
+
+	/** move the unread characters to the front of buffer and read the next chunk after them */
+	bool fill()
+	{
+		if(!stream_ || !*stream_)
+		{
+			return false;
+		}
+		const size_t remaining = static_cast<size_t>(last_ - cursor_);
+		if(remaining != 0 && cursor_ != &buffer_[0])
+		{
+			std::char_traits<CharT>::move(&buffer_[0], cursor_, remaining);
+		}
+		if(remaining == buffer_.size())
+		{
+			buffer_.resize(buffer_.size() * 2);
+		}
+		stream_->read(&buffer_[remaining], static_cast<std::streamsize>(buffer_.size() - remaining));
+		const size_t read = static_cast<size_t>(stream_->gcount());
+		cursor_ = &buffer_[0];
+		last_ = cursor_ + remaining + read;
+		return read != 0;
+	}
+	void split(const CharT* first, const CharT* last)
+	{
+		typedef std::char_traits<CharT> traits;
+		fields_.clear();
+		for(;;)
+		{
+			const CharT* const delimiter = traits::find(first, static_cast<size_t>(last - first), field_delimiter_);
+			if(!delimiter)
+			{
+				fields_.push_back(range_type(first, last));
+				return;
+			}
+			fields_.push_back(range_type(first, delimiter));
+			first = delimiter + 1;
+		}
+	}
+
+	std::basic_istream<CharT>* stream_;
+	std::vector<CharT> buffer_;
+	const CharT* cursor_;
+	const CharT* last_;
+	CharT field_delimiter_;
+	CharT record_delimiter_;
+	size_t record_number_;
+	std::vector<range_type> fields_;
+};
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief append fields of the current record to columns from index
+	 */
+	//---------------------------------------------------------------------------
+	template<typename CharT>
+	inline void append_columns(const intelligent_cast_reader<CharT>& /*reader*/, size_t /*index*/)
+	{
+	}
+	template<typename CharT, typename T, typename... Columns>
+	inline void append_columns(const intelligent_cast_reader<CharT>& reader, size_t index, std::vector<T>& column, std::vector<Columns>&... columns)
+	{
+		column.push_back(reader.template get<T>(index));
+		append_columns(reader, index + 1, columns...);
+	}
+}	// End Of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   read all remaining records into typed columns
+ * @param[in,out] reader reader of records
+ * @param[in,out] columns one std::vector for each field, the i-th field is appended to the i-th vector
+ * @returns the number of records read
+ *
+ * a missing field is appended as 0, and fields after the last column are ignored.
+ */
+//---------------------------------------------------------------------------
+template<typename CharT, typename... Columns>
+size_t intelligent_cast_read_columns(intelligent_cast_reader<CharT>& reader, std::vector<Columns>&... columns)
+{
+	size_t count = 0;
+	while(reader.next())
+	{
+		intelligent_cast_detail::append_columns(reader, 0, columns...);
+		++count;
+	}
+	return count;
+}
@@ -0,0 +1,303 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+//---------------------------------------------------------------------------
+// statistics of intelligent_cast, which are recorded only when INTELLIGENT_CAST_ENABLE_STATISTICS is defined
+// before "IntelligentCast.h" is included. otherwise this header is not included and intelligent_cast is not changed.
+//---------------------------------------------------------------------------
+
+// one call of every INTELLIGENT_CAST_STATISTICS_SAMPLE_PERIOD calls (power of two) in each thread is timed
+#if !defined(INTELLIGENT_CAST_STATISTICS_SAMPLE_PERIOD)
+#define INTELLIGENT_CAST_STATISTICS_SAMPLE_PERIOD 64
+#endif
+
+static_assert((INTELLIGENT_CAST_STATISTICS_SAMPLE_PERIOD & (INTELLIGENT_CAST_STATISTICS_SAMPLE_PERIOD - 1)) == 0,
+	"INTELLIGENT_CAST_STATISTICS_SAMPLE_PERIOD must be a power of two.");
+
+//---------------------------------------------------------------------------
+/**
+ * @brief statistics of conversion from one type to another, summed over all threads
+ *
+ *	numeric types and std::string, std::wstring are named as in the source ("unsigned long long"),
+ *	other types by the demangled std::type_info::name. executor is the kind of cast_executor such as "numeric<-string".\n
+ *	latency[0] is the number of sampled calls which took less than 1ns,
+ *	and latency[i] is the number of those which took [2^(i-1), 2^i) nanoseconds. the last bucket has no upper bound.
+ */
+//---------------------------------------------------------------------------
+struct intelligent_cast_pair_statistics
+{
+	enum { latency_buckets = 32 };
+
+	const char* to;
+	const char* from;
+	const char* executor;
+	unsigned long long calls;
+	unsigned long long failures;	///< parses which try_intelligent_cast does not report as ok
+	unsigned long long bytes;		///< bytes of characters in the resulting strings
+	unsigned long long latency[latency_buckets];
+};
+
+namespace intelligent_cast_detail
+{
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief counters of one type pair in one thread
+	 *
+	 *	only the owner thread writes them, so they are updated by plain load and store without lock prefix,
+	 *	and atomic only to be read by snapshot from another thread.
+	 */
+	//---------------------------------------------------------------------------
+	struct statistics_counters
+	{
+		std::atomic<unsigned long long> calls;
+		std::atomic<unsigned long long> failures;
+		std::atomic<unsigned long long> bytes;
+		std::atomic<unsigned long long> latency[intelligent_cast_pair_statistics::latency_buckets];
+		std::atomic<bool> owned;		///< false after the owner thread exits, then the next new thread takes over
+		statistics_counters* next;
+
+		statistics_counters()
+			: calls(0)
+			, failures(0)
+			, bytes(0)
+			, owned(true)
+			, next(NULL)
+		{
+			for(size_t i = 0; i < intelligent_cast_pair_statistics::latency_buckets; ++i)
+			{
+				latency[i].store(0, std::memory_order_relaxed);
+			}
+		}
+
+		static void add(std::atomic<unsigned long long>& counter, unsigned long long value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+		/** true if the next call is timed */
+		bool sample() const
+		{
+			return (calls.load(std::memory_order_relaxed) & (INTELLIGENT_CAST_STATISTICS_SAMPLE_PERIOD - 1)) == 0;
+		}
+		void record(bool failed, size_t bytes_produced)
+		{
+			add(calls, 1);
+			add(failures, failed ? 1 : 0);
+			add(bytes, bytes_produced);
+		}
+		void record_latency(std::chrono::steady_clock::duration elapsed)
+		{
+			unsigned long long nanoseconds = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+			size_t bucket = 0;
+			while(nanoseconds != 0 && bucket + 1 < intelligent_cast_pair_statistics::latency_buckets)
+			{
+				nanoseconds >>= 1;
+				++bucket;
+			}
+			add(latency[bucket], 1);
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief type pair which has the counters of every thread which converted it
+	 *
+	 *	pairs and counters are pushed to lock-free lists and never removed.
+	 *	the counters of an exited thread are released with its totals, which are the retired totals of the pair,
+	 *	and a new thread takes over released counters and adds to them instead of allocating.
+	 *	so the number of counters is the largest number of threads converting the pair at the same time,
+	 *	and the sums of snapshots never decrease.
+	 */
+	//---------------------------------------------------------------------------
+	struct statistics_pair
+	{
+		const char* to;
+		const char* from;
+		const char* executor;
+		std::atomic<statistics_counters*> threads;
+		statistics_pair* next;
+
+		statistics_pair(const char* to_name, const char* from_name, const char* executor_name)
+			: to(to_name)
+			, from(from_name)
+			, executor(executor_name)
+			, threads(NULL)
+			, next(NULL)
+		{
+			std::atomic<statistics_pair*>& head = pairs();
+			next = head.load(std::memory_order_relaxed);
+			while(!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed))
+			{
+			}
+		}
+		/** counters of the calling thread, which are taken over or created at the first call of each thread */
+		statistics_counters* attach()
+		{
+			for(statistics_counters* released = threads.load(std::memory_order_acquire); released; released = released->next)
+			{
+				bool owned = false;
+				if(!released->owned.load(std::memory_order_relaxed) &&
+					released->owned.compare_exchange_strong(owned, true, std::memory_order_acquire, std::memory_order_relaxed))
+				{
+					return released;
+				}
+			}
+			statistics_counters* const counters = new statistics_counters();
+			counters->next = threads.load(std::memory_order_relaxed);
+			while(!threads.compare_exchange_weak(counters->next, counters, std::memory_order_release, std::memory_order_relaxed))
+			{
+			}
+			return counters;
+		}
+
+		/** release counters of the exiting thread, the counts written by it are visible to the thread which takes over */
+		static void detach(statistics_counters* counters)
+		{
+			counters->owned.store(false, std::memory_order_release);
+		}
+
+		static std::atomic<statistics_pair*>& pairs()
+		{
+			static std::atomic<statistics_pair*> head(NULL);
+			return head;
+		}
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief counters of one type pair held by the calling thread until it exits
+	 */
+	//---------------------------------------------------------------------------
+	class statistics_thread_counters
+	{
+	public:
+		explicit statistics_thread_counters(statistics_pair& pair)
+			: counters_(pair.attach())
+		{
+		}
+		~statistics_thread_counters()
+		{
+			statistics_pair::detach(counters_);
+		}
+		statistics_counters& get() const	{ return *counters_; }
+	private:
+		statistics_thread_counters(const statistics_thread_counters&);
+		statistics_thread_counters& operator=(const statistics_thread_counters&);
+
+		statistics_counters* const counters_;
+	};
+
+	//---------------------------------------------------------------------------
+	/**
+	 * @brief readable name of type from std::type_info::name
+	 *
+	 *	the name is demangled by the C++ ABI of GCC and Clang. the name of MSVC is already readable.
+	 */
+	//---------------------------------------------------------------------------
+	inline std::string statistics_demangle(const char* name)
+	{
+#if defined(__GNUG__)
+		int status = 0;
+		char* const demangled = abi::__cxa_demangle(name, NULL, NULL, &status);
+		if(demangled)
+		{
+			const std::string result = status == 0 ? std::string(demangled) : std::string(name);
+			std::free(demangled);
+			return result;
+		}
+#endif
+		return name;
+	}
+
+	// name of type in statistics, specialized in "IntelligentCast.h" for numeric types and std::string, std::wstring
+	template<typename T>
+	struct statistics_type_name
+	{
+		static const char* get()
+		{
+			static const std::string name = statistics_demangle(typeid(T).name());
+			return name.c_str();
+		}
+	};
+}	// End Of Namespace intelligent_cast_detail
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   statistics of every type pair converted so far
+ * @returns one element for each type pair, the counters of all threads are summed
+ *
+ * counters are never reset, so the statistics of an interval are the difference of two snapshots.
+ * the counters of a thread which is converting at the same time may be a few calls behind.
+ */
+//---------------------------------------------------------------------------
+inline std::vector<intelligent_cast_pair_statistics> intelligent_cast_statistics_snapshot()
+{
+	using namespace intelligent_cast_detail;
+	std::vector<intelligent_cast_pair_statistics> snapshot;
+	for(const statistics_pair* pair = statistics_pair::pairs().load(std::memory_order_acquire); pair; pair = pair->next)
+	{
+		intelligent_cast_pair_statistics statistics = { pair->to, pair->from, pair->executor, 0, 0, 0, {} };
+		for(const statistics_counters* counters = pair->threads.load(std::memory_order_acquire); counters; counters = counters->next)
+		{
+			statistics.calls += counters->calls.load(std::memory_order_relaxed);
+			statistics.failures += counters->failures.load(std::memory_order_relaxed);
+			statistics.bytes += counters->bytes.load(std::memory_order_relaxed);
+			for(size_t i = 0; i < intelligent_cast_pair_statistics::latency_buckets; ++i)
+			{
+				statistics.latency[i] += counters->latency[i].load(std::memory_order_relaxed);
+			}
+		}
+		snapshot.push_back(statistics);
+	}
+	return snapshot;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * @brief   write statistics as CSV
+ * @param[in,out] stream output stream
+ * @param[in] snapshot statistics returned by intelligent_cast_statistics_snapshot
+ *
+ * one line for each type pair: to,from,executor,calls,failures,bytes and the latency buckets.
+ */
+//---------------------------------------------------------------------------
+inline std::ostream& intelligent_cast_statistics_dump(std::ostream& stream, const std::vector<intelligent_cast_pair_statistics>& snapshot)
+{
+	stream << "to,from,executor,calls,failures,bytes";
+	for(size_t i = 0; i < intelligent_cast_pair_statistics::latency_buckets; ++i)
+	{
+		if(i + 1 < intelligent_cast_pair_statistics::latency_buckets)
+		{
+			stream << ",latency<" << (1ULL << i) << "ns";
+		}
+		else
+		{
+			stream << ",latency>=" << (1ULL << (i - 1)) << "ns";
+		}
+	}
+	stream << '\n';
+	for(size_t index = 0; index < snapshot.size(); ++index)
+	{
+		const intelligent_cast_pair_statistics& statistics = snapshot[index];
+		stream << '"' << statistics.to << "\",\"" << statistics.from << "\"," << statistics.executor << ','
+			<< statistics.calls << ',' << statistics.failures << ',' << statistics.bytes;
+		for(size_t i = 0; i < intelligent_cast_pair_statistics::latency_buckets; ++i)
+		{
+			stream << ',' << statistics.latency[i];
+		}
+		stream << '\n';
+	}
+	return stream;
+}
+inline std::ostream& intelligent_cast_statistics_dump(std::ostream& stream)
+{
+	return intelligent_cast_statistics_dump(stream, intelligent_cast_statistics_snapshot());
+}
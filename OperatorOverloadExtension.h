@@ -27,9 +27,9 @@ namespace intelligent_cast_detail
 	>
 	class is_string_castable
 	{
-		template<typename T, typename U>
-		static auto check(typename string_converter<T,U>::value_type*) -> std::true_type;
-		template<typename T, typename U>
+		template<typename T2, typename U2>
+		static auto check(typename string_converter<T2,U2>::value_type*) -> std::true_type;
+		template<typename T2, typename U2>
 		static auto check(...) -> std::false_type;
 
 		typedef decltype(check<T,U>(nullptr)) result_type;
@@ -43,13 +43,13 @@ namespace intelligent_cast_detail
 	>
 	class is_addable
 	{
-		template<typename T, typename U>
-		static auto check(T*, U*) -> decltype
+		template<typename T2, typename U2>
+		static auto check(T2*, U2*) -> decltype
 			(
-				std::declval<T>(0) + std::declval<U>(0),
+				std::declval<T2>(0) + std::declval<U2>(0),
 				std::true_type()
 			);
-		template<typename T, typename U>
+		template<typename T2, typename U2>
 		static auto check(...) -> std::false_type;
 			
 		typedef decltype(check<T,U>(nullptr,nullptr)) result_type;
@@ -67,10 +67,27 @@ namespace intelligent_cast_detail
 	};
 }
 
+// std::string + value, the result is built with one allocation
 template<typename StrType, typename T>
 inline typename std::enable_if< 
 	intelligent_cast_detail::can_allow_adding_operator<StrType,T>::value
 	, StrType>::type operator+(const StrType& str, const T& t)
 {
-	return str+intelligent_cast<StrType>(t);
-}
\ No newline at end of file
+	using namespace intelligent_cast_detail;
+	StrType result;
+	result.reserve(str.size() + append_executor<T>::template length_bound<typename StrType::value_type>(t));
+	result.append(str);
+	append_executor<T>::append(result, t);
+	return result;
+}
+
+// rvalue std::string + value, the text is appended in place to the buffer of str (str + 10 + " and " + 5.5 reuses it to the end)
+template<typename StrType, typename T>
+inline typename std::enable_if< 
+	intelligent_cast_detail::can_allow_adding_operator<StrType,T>::value
+	, StrType>::type operator+(StrType&& str, const T& t)
+{
+	using namespace intelligent_cast_detail;
+	append_executor<T>::append(str, t);
+	return std::move(str);
+}
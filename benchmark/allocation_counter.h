@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+//---------------------------------------------------------------------------
+// every allocation is counted by replacing the global operator new and delete, so that the allocations of a conversion
+// are reported with its time. include this header in exactly one translation unit of the benchmark program.
+//---------------------------------------------------------------------------
+
+#if defined(_MSC_VER)
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+namespace allocation
+{
+	size_t count = 0;
+	size_t bytes = 0;
+}
+
+//---------------------------------------------------------------------------
+// every form of operator new and delete forwards to the counting pair, so that an allocation of one form is never
+// released by the default deallocation of another form.
+// the pair is not inlined, otherwise malloc or free is seen against operator delete or new (-Wmismatched-new-delete).
+//---------------------------------------------------------------------------
+BENCHMARK_NOINLINE void* operator new(size_t size)
+{
+	++allocation::count;
+	allocation::bytes += size;
+	if(void* p = std::malloc(size ? size : 1))
+	{
+		return p;
+	}
+	throw std::bad_alloc();
+}
+BENCHMARK_NOINLINE void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	try
+	{
+		return operator new(size);
+	}
+	catch(const std::bad_alloc&)
+	{
+		return NULL;
+	}
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return operator new(size, std::nothrow);
+}
+void operator delete[](void* p) noexcept
+{
+	operator delete(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+	operator delete(p);
+}
+void operator delete[](void* p, size_t) noexcept
+{
+	operator delete(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	operator delete(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	operator delete(p);
+}
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdio>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../IntelligentCast.h"
+
+// requires C++17 (/std:c++17) for std::pmr
+
+// one request converts this many values, and its strings are kept until the request ends
+const size_t values_per_request = 256;
+const size_t requests_per_thread = 4000;
+
+// a value which does not fit in the small string buffer, so every string is allocated
+const long long long_value = 1234567890123456789LL;
+
+// each request keeps its results in a vector of strings from the global heap
+unsigned long long request_global_heap(int seed)
+{
+	std::vector<std::string> results;
+	results.reserve(values_per_request);
+	unsigned long long length = 0;
+	for(size_t i = 0; i < values_per_request; ++i)
+	{
+		results.push_back(intelligent_cast<std::string>(long_value + seed + static_cast<long long>(i)));
+		results.push_back(intelligent_cast<std::string>(results.back()) + "/");
+	}
+	for(size_t i = 0; i < results.size(); ++i) length += results[i].size();
+	return length;
+}
+
+// each request keeps its results in a monotonic arena on the stack, which is released at once
+unsigned long long request_arena(int seed)
+{
+	char buffer[64 * 1024];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+	std::pmr::vector<std::pmr::string> results(&arena);
+	results.reserve(values_per_request);
+	unsigned long long length = 0;
+	for(size_t i = 0; i < values_per_request; ++i)
+	{
+		results.push_back(intelligent_cast<std::pmr::string>(long_value + seed + static_cast<long long>(i), &arena));
+		results.push_back(intelligent_cast<std::pmr::string>(results.back(), &arena));
+		results.back() += "/";
+	}
+	for(size_t i = 0; i < results.size(); ++i) length += results[i].size();
+	return length;
+}
+
+template<typename Request>
+void run(const char* name, unsigned int threads, Request request)
+{
+	std::vector<unsigned long long> checksums(threads);
+	const std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+	std::vector<std::thread> workers;
+	for(unsigned int t = 0; t < threads; ++t)
+	{
+		workers.push_back(std::thread([&, t]()
+		{
+			for(size_t r = 0; r < requests_per_thread; ++r)
+			{
+				checksums[t] += request(static_cast<int>(r));
+			}
+		}));
+	}
+	for(size_t t = 0; t < workers.size(); ++t)
+	{
+		workers[t].join();
+	}
+	const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	unsigned long long checksum = 0;
+	for(size_t t = 0; t < checksums.size(); ++t) checksum += checksums[t];
+	// conversions per thread take the same time if threads do not contend
+	const double ns = std::chrono::duration<double, std::nano>(end - begin).count() / (requests_per_thread * values_per_request * 2);
+	printf("%-28s %2u threads %8.2f ns/conversion per thread  (checksum %llu)\n", name, threads, ns, checksum);
+}
+
+int main()
+{
+	const unsigned int max_threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+	for(unsigned int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		run("std::string (global heap)", threads, request_global_heap);
+		run("std::pmr::string (arena)", threads, request_arena);
+	}
+	return 0;
+}
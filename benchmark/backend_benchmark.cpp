@@ -0,0 +1,123 @@
+#define _CRT_SECURE_NO_WARNINGS
+#define INTELLIGENT_CAST_USE_CHARCONV
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "benchmark_harness.h"
+
+// requires C++17 (/std:c++17) for the std::to_chars backend, otherwise only the self-contained routines are measured
+
+const size_t count = 1 << 20;
+
+template<typename T>
+std::vector<T> make_values(unsigned long long range)
+{
+	std::vector<T> values(count);
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < count; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		values[i] = static_cast<T>(range ? state % range : state);
+	}
+	return values;
+}
+std::vector<double> make_doubles()
+{
+	std::vector<double> values = make_values<double>(1000000);
+	for(size_t i = 0; i < count; ++i)
+	{
+		values[i] /= 64.0 + static_cast<double>(i % 7);
+	}
+	return values;
+}
+
+// the text of both backends must be the same, and the same as the format string of the printf family
+template<typename Backend, typename T>
+size_t mismatches(const std::vector<T>& values, const char* format)
+{
+	size_t result = 0;
+	char buf[64];
+	char expected[64];
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		char* const end = Backend::write(buf, buf + sizeof(buf), values[i]);
+		if(format)
+		{
+			snprintf(expected, sizeof(expected), format, values[i]);
+			result += std::string(buf, end) != expected;
+		}
+		else
+		{
+			// floating point text must be the shortest one which strtod reads back to the same value
+			*end = '\0';
+			result += static_cast<T>(std::strtod(buf, NULL)) != values[i];
+		}
+		T value;
+		bool out_of_range;
+		result += Backend::parse(buf, end, value, out_of_range) != end || value != values[i];
+	}
+	return result;
+}
+
+template<typename Backend, typename T>
+void run(const char* name, const char* backend, const std::vector<T>& values, const char* format)
+{
+	char text[64];
+	std::vector<size_t> offsets(values.size() + 1);
+	std::string texts;
+	size_t checksum = 0;
+	const double format_ns = measure([&]()
+	{
+		char buf[64];
+		for(size_t i = 0; i < values.size(); ++i)
+		{
+			checksum += Backend::write(buf, buf + sizeof(buf), values[i]) - buf;
+		}
+	}) / count;
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		offsets[i] = texts.size();
+		texts.append(text, Backend::write(text, text + sizeof(text), values[i]));
+	}
+	offsets[values.size()] = texts.size();
+	const double parse_ns = measure([&]()
+	{
+		for(size_t i = 0; i < values.size(); ++i)
+		{
+			T value;
+			bool out_of_range;
+			Backend::parse(texts.data() + offsets[i], texts.data() + offsets[i + 1], value, out_of_range);
+			checksum += static_cast<size_t>(value);
+		}
+	}) / count;
+	printf("%-20s %-16s %10.2f %10.2f %12u  (checksum %u)\n", name, backend, format_ns, parse_ns,
+		static_cast<unsigned int>(mismatches<Backend>(values, format)), static_cast<unsigned int>(checksum));
+}
+
+template<typename T>
+void compare(const char* name, const std::vector<T>& values, const char* format)
+{
+	run<intelligent_cast_detail::self_contained_backend<T, char> >(name, "self-contained", values, format);
+#if defined(INTELLIGENT_CAST_HAS_CHARCONV)
+	run<intelligent_cast_detail::charconv_backend<T> >(name, "std::to_chars", values, format);
+#endif
+}
+
+int main()
+{
+	printf("%-20s %-16s %10s %10s %12s\n", "type", "backend", "format ns", "parse ns", "mismatches");
+	compare("int [0, 10000)", make_values<int>(10000), "%d");
+	compare("int", make_values<int>(0), "%d");
+	compare("unsigned short", make_values<unsigned short>(0), "%hu");
+	compare("long long", make_values<long long>(0), "%lld");
+	compare("unsigned long long", make_values<unsigned long long>(0), "%llu");
+	compare("double", make_doubles(), NULL);
+	compare("double [0, 2^64)", make_values<double>(0), NULL);
+	return 0;
+}
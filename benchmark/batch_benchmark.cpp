@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "../IntelligentCastBatch.h"
+#include "benchmark_harness.h"
+
+// values are generated with a fixed seed so that every run converts the same input
+template<typename T>
+std::vector<T> make_values(size_t count)
+{
+	std::vector<T> values(count);
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < count; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		// magnitudes are spread over every number of digits
+		values[i] = static_cast<T>(state >> (state % 64));
+	}
+	return values;
+}
+
+template<typename T>
+void compare(const char* type_name, size_t count)
+{
+	char name[128];
+	const std::vector<T> values = make_values<T>(count);
+	std::string text;
+	std::vector<size_t> offsets(count + 1);
+
+	snprintf(name, sizeof(name), "%s -> string intelligent_cast_append", type_name);
+	run(name, count, [&]() -> unsigned long long
+	{
+		text.clear();
+		for(size_t i = 0; i < count; ++i)
+		{
+			offsets[i] = text.size();
+			intelligent_cast_append(text, values[i]);
+		}
+		offsets[count] = text.size();
+		return text.size();
+	});
+
+	snprintf(name, sizeof(name), "%s -> string intelligent_cast_format_batch", type_name);
+	run(name, count, [&]() -> unsigned long long
+	{
+		text.clear();
+		intelligent_cast_format_batch(values.data(), count, text, offsets.data());
+		return text.size();
+	});
+
+	std::vector<T> parsed(count);
+	snprintf(name, sizeof(name), "string -> %s intelligent_cast", type_name);
+	run(name, count, [&]() -> unsigned long long
+	{
+		unsigned long long sum = 0;
+		const char* data = text.data();
+		for(size_t i = 0; i < count; ++i) sum += static_cast<unsigned long long>(intelligent_cast<T>(data + offsets[i], data + offsets[i + 1]));
+		return sum;
+	});
+
+	snprintf(name, sizeof(name), "string -> %s intelligent_cast_parse_batch", type_name);
+	run(name, count, [&]() -> unsigned long long
+	{
+		unsigned long long sum = intelligent_cast_parse_batch(text.data(), offsets.data(), count, parsed.data());
+		for(size_t i = 0; i < count; ++i) sum += static_cast<unsigned long long>(parsed[i]);
+		return sum;
+	});
+}
+
+int main()
+{
+	const size_t count = 1000000;
+
+	compare<int>("int", count);
+	compare<long long>("long long", count);
+	compare<unsigned long long>("unsigned long long", count);
+
+	return 0;
+}
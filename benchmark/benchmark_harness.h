@@ -0,0 +1,54 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+//---------------------------------------------------------------------------
+// timing harness shared by the benchmarks.
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+/**
+ * @brief elapsed nanoseconds of one call of func
+ */
+//---------------------------------------------------------------------------
+template<typename Func>
+double measure(Func func)
+{
+	const std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+	func();
+	return std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count();
+}
+//---------------------------------------------------------------------------
+/**
+ * @brief elapsed nanoseconds of one call of func, whose result is stored to checksum
+ */
+//---------------------------------------------------------------------------
+template<typename Func, typename Checksum>
+double measure(Func func, Checksum& checksum)
+{
+	return measure([&]() { checksum = func(); });
+}
+//---------------------------------------------------------------------------
+/**
+ * @brief call func repeat times, and print nanoseconds per unit and the sum of the results of func
+ * @param name name of the row
+ * @param count the number of units (values, records or characters) processed by one call of func
+ * @param func function which returns a checksum, so that the work is not optimized away
+ * @param repeat the number of calls
+ * @param unit name of the unit
+ */
+//---------------------------------------------------------------------------
+template<typename Func>
+void run(const char* name, size_t count, Func func, int repeat = 20, const char* unit = "op")
+{
+	unsigned long long checksum = 0;
+	const double ns = measure([&]()
+	{
+		for(int r = 0; r < repeat; ++r)
+		{
+			checksum += func();
+		}
+	});
+	printf("%-48s %8.2f ns/%s  (checksum %llu)\n", name, ns / (static_cast<double>(count) * repeat), unit, checksum);
+}
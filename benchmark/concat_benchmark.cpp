@@ -0,0 +1,58 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "../OperatorOverloadExtension.h"
+#include "benchmark_harness.h"
+
+// operator+ of the first release (every step converts the value to a temporary string and returns a new string)
+namespace legacy
+{
+	template<typename T>
+	std::string add(const std::string& str, const T& t)
+	{
+		return str + intelligent_cast<std::string>(t);
+	}
+}
+
+int main()
+{
+	const size_t count = 1000000;
+	const std::string prefix = "request finished with status ";
+
+	run("log message legacy operator+", count, [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < count; ++i)
+		{
+			const std::string message = legacy::add(legacy::add(legacy::add(legacy::add(prefix, static_cast<int>(i % 600)), " in "), i * 0.001), " ms");
+			length += message.size();
+		}
+		return length;
+	});
+
+	run("log message operator+ appending in place", count, [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < count; ++i)
+		{
+			const std::string message = prefix + static_cast<int>(i % 600) + " in " + i * 0.001 + " ms";
+			length += message.size();
+		}
+		return length;
+	});
+
+	run("log message intelligent_cast_concat", count, [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < count; ++i)
+		{
+			const std::string message = intelligent_cast_concat(prefix, static_cast<int>(i % 600), " in ", i * 0.001, " ms");
+			length += message.size();
+		}
+		return length;
+	});
+
+	return 0;
+}
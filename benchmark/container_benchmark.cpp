@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCastContainer.h"
+#include "allocation_counter.h"
+#include "benchmark_harness.h"
+
+const size_t elements = 1000;
+const int repeat = 2000;
+
+// a hand-written join, which builds one temporary string per element
+std::string join_loop(const std::vector<double>& values)
+{
+	std::string text;
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		if(i != 0)
+		{
+			text += ',';
+		}
+		text += std::to_string(values[i]);
+	}
+	return text;
+}
+
+// a hand-written split, which builds one substring per field
+std::vector<double> split_loop(const std::string& text)
+{
+	std::vector<double> values;
+	size_t first = 0;
+	while(first <= text.size())
+	{
+		size_t last = text.find(',', first);
+		if(last == std::string::npos)
+		{
+			last = text.size();
+		}
+		values.push_back(std::stod(text.substr(first, last - first)));
+		first = last + 1;
+	}
+	return values;
+}
+
+// time and allocations per call, which are counted by the replaced operator new
+template<typename Func>
+void run_counted(const char* name, Func func)
+{
+	size_t checksum = 0;
+	const size_t count_before = allocation::count;
+	const double ns = measure([&]()
+	{
+		for(int r = 0; r < repeat; ++r)
+		{
+			checksum += func();
+		}
+	});
+	printf("%-36s %10.2f us/call %10.2f allocs/call  (checksum %u)\n", name,
+		ns / 1000 / repeat,
+		static_cast<double>(allocation::count - count_before) / repeat,
+		static_cast<unsigned int>(checksum));
+}
+
+int main()
+{
+	std::vector<double> values(elements);
+	for(size_t i = 0; i < elements; ++i)
+	{
+		values[i] = static_cast<double>(i * 7919 % 100000) / 64.0;
+	}
+	const std::string text = intelligent_cast<std::string>(values);
+
+	printf("%u doubles, %u characters\n", static_cast<unsigned int>(elements), static_cast<unsigned int>(text.size()));
+	run_counted("join: std::to_string loop", [&]() { return join_loop(values).size(); });
+	run_counted("join: intelligent_cast<std::string>", [&]() { return intelligent_cast<std::string>(values).size(); });
+	run_counted("split: substr + std::stod loop", [&]() { return split_loop(text).size(); });
+	run_counted("split: intelligent_cast<std::vector>", [&]() { return intelligent_cast<std::vector<double> >(text).size(); });
+	return 0;
+}
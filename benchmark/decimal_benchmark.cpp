@@ -0,0 +1,119 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "../IntelligentCastDecimal.h"
+#include "benchmark_harness.h"
+
+// prices with 4 fraction digits as they arrive in a feed, such as "123.4500"
+const size_t count = 1 << 20;
+
+std::vector<std::string> make_prices()
+{
+	std::vector<std::string> prices(count);
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < count; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		prices[i] = intelligent_cast<std::string>(intelligent_cast_decimal<4>::from_units(static_cast<long long>(state % 100000000)));
+	}
+	return prices;
+}
+
+void report(const char* name, double ns, size_t inexact, long long checksum)
+{
+	printf("%-56s %8.2f ns/op %8u inexact  (checksum %lld)\n", name, ns, static_cast<unsigned int>(inexact), checksum);
+}
+
+// text -> scaled integer, inexact counts the values which are not the units of the text
+template<typename Parse>
+void parse(const char* name, const std::vector<std::string>& prices, const std::vector<long long>& expected, Parse parse_one)
+{
+	std::vector<long long> units(count);
+	long long checksum = 0;
+	const double ns = measure([&]()
+	{
+		long long sum = 0;
+		for(size_t i = 0; i < count; ++i)
+		{
+			units[i] = parse_one(prices[i]);
+			sum += units[i];
+		}
+		return sum;
+	}, checksum) / count;
+	size_t inexact = 0;
+	for(size_t i = 0; i < count; ++i)
+	{
+		inexact += units[i] != expected[i];
+	}
+	report(name, ns, inexact, checksum);
+}
+
+// scaled integer -> text, inexact counts the texts which differ from the feed
+template<typename Format>
+void format(const char* name, const std::vector<std::string>& prices, const std::vector<long long>& units, Format format_one)
+{
+	std::string text;
+	std::vector<size_t> offsets(count + 1);
+	long long checksum = 0;
+	const double ns = measure([&]()
+	{
+		for(size_t i = 0; i < count; ++i)
+		{
+			offsets[i] = text.size();
+			format_one(text, units[i]);
+		}
+		offsets[count] = text.size();
+		return static_cast<long long>(text.size());
+	}, checksum) / count;
+	size_t inexact = 0;
+	for(size_t i = 0; i < count; ++i)
+	{
+		inexact += text.compare(offsets[i], offsets[i + 1] - offsets[i], prices[i]) != 0;
+	}
+	report(name, ns, inexact, checksum);
+}
+
+int main()
+{
+	const std::vector<std::string> prices = make_prices();
+	std::vector<long long> units(count);
+	for(size_t i = 0; i < count; ++i)
+	{
+		units[i] = intelligent_cast<intelligent_cast_decimal<4> >(prices[i]).units();
+	}
+
+	parse("atof, then scaled", prices, units, [](const std::string& price)
+	{
+		return static_cast<long long>(std::atof(price.c_str()) * 10000);
+	});
+	parse("intelligent_cast<double>, then rounded", prices, units, [](const std::string& price)
+	{
+		return std::llround(intelligent_cast<double>(price) * 10000);
+	});
+	parse("intelligent_cast<intelligent_cast_decimal<4> >", prices, units, [](const std::string& price)
+	{
+		return intelligent_cast<intelligent_cast_decimal<4> >(price).units();
+	});
+
+	format("snprintf(\"%.4f\") of units / 10000.0", prices, units, [](std::string& text, long long value)
+	{
+		char buf[32];
+		text.append(buf, static_cast<size_t>(snprintf(buf, sizeof(buf), "%.4f", value / 10000.0)));
+	});
+	format("intelligent_cast_append of double", prices, units, [](std::string& text, long long value)
+	{
+		intelligent_cast_append(text, value / 10000.0);
+	});
+	format("intelligent_cast_append of intelligent_cast_decimal<4>", prices, units, [](std::string& text, long long value)
+	{
+		intelligent_cast_append(text, intelligent_cast_decimal<4>::from_units(value));
+	});
+	return 0;
+}
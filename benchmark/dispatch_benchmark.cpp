@@ -0,0 +1,168 @@
+#include <any>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCastDispatch.h"
+#include "benchmark_harness.h"
+
+// requires C++17 (/std:c++17) for std::any of the virtual adapter
+
+// rows of text whose column types are known only at runtime, as read from a database or a config
+const size_t rows = 200000;
+const intelligent_cast_tag column_tags[] =
+{
+	intelligent_cast_tag::int_, intelligent_cast_tag::double_, intelligent_cast_tag::longlong_,
+	intelligent_cast_tag::ushort_, intelligent_cast_tag::float_, intelligent_cast_tag::uint_
+};
+const size_t columns = sizeof(column_tags) / sizeof(column_tags[0]);
+
+std::vector<std::string> make_cells()
+{
+	std::vector<std::string> cells(rows * columns);
+	for(size_t r = 0; r < rows; ++r)
+	{
+		for(size_t c = 0; c < columns; ++c)
+		{
+			const long long value = static_cast<long long>((r * 7919 + c * 104729) % 60000);
+			cells[r * columns + c] = column_tags[c] == intelligent_cast_tag::double_ || column_tags[c] == intelligent_cast_tag::float_
+				? intelligent_cast<std::string>(value / 8.0) : intelligent_cast<std::string>(value);
+		}
+	}
+	return cells;
+}
+
+// a switch over the tag for every cell
+double parse_switch(intelligent_cast_tag tag, const std::string& text)
+{
+	switch(tag)
+	{
+	case intelligent_cast_tag::int_:		return intelligent_cast<int>(text);
+	case intelligent_cast_tag::uint_:		return intelligent_cast<unsigned int>(text);
+	case intelligent_cast_tag::ushort_:		return intelligent_cast<unsigned short>(text);
+	case intelligent_cast_tag::longlong_:	return static_cast<double>(intelligent_cast<long long>(text));
+	case intelligent_cast_tag::float_:		return intelligent_cast<float>(text);
+	case intelligent_cast_tag::double_:		return intelligent_cast<double>(text);
+	default:								return 0;
+	}
+}
+
+// an adapter for each column, which boxes the value in std::any
+struct column_adapter
+{
+	virtual ~column_adapter() {}
+	virtual std::any parse(const std::string& text) const = 0;
+	virtual double to_double(const std::any& value) const = 0;
+};
+template<typename T>
+struct typed_adapter : column_adapter
+{
+	std::any parse(const std::string& text) const		{ return intelligent_cast<T>(text); }
+	double to_double(const std::any& value) const		{ return static_cast<double>(std::any_cast<T>(value)); }
+};
+std::unique_ptr<column_adapter> make_adapter(intelligent_cast_tag tag)
+{
+	switch(tag)
+	{
+	case intelligent_cast_tag::int_:		return std::unique_ptr<column_adapter>(new typed_adapter<int>());
+	case intelligent_cast_tag::uint_:		return std::unique_ptr<column_adapter>(new typed_adapter<unsigned int>());
+	case intelligent_cast_tag::ushort_:		return std::unique_ptr<column_adapter>(new typed_adapter<unsigned short>());
+	case intelligent_cast_tag::longlong_:	return std::unique_ptr<column_adapter>(new typed_adapter<long long>());
+	case intelligent_cast_tag::float_:		return std::unique_ptr<column_adapter>(new typed_adapter<float>());
+	default:								return std::unique_ptr<column_adapter>(new typed_adapter<double>());
+	}
+}
+
+// one pass over the cells of all rows
+template<typename Func>
+void run_cells(const char* name, Func func)
+{
+	double checksum = 0;
+	const double ns = measure(func, checksum);
+	printf("%-40s %8.2f ns/cell  (checksum %.0f)\n", name, ns / (rows * columns), checksum);
+}
+
+int main()
+{
+	const std::vector<std::string> cells = make_cells();
+
+	run_cells("switch over tag per cell", [&]()
+	{
+		double sum = 0;
+		for(size_t r = 0; r < rows; ++r)
+		{
+			for(size_t c = 0; c < columns; ++c)
+			{
+				sum += parse_switch(column_tags[c], cells[r * columns + c]);
+			}
+		}
+		return sum;
+	});
+
+	run_cells("virtual adapter with std::any", [&]()
+	{
+		std::vector<std::unique_ptr<column_adapter> > adapters;
+		for(size_t c = 0; c < columns; ++c)
+		{
+			adapters.push_back(make_adapter(column_tags[c]));
+		}
+		double sum = 0;
+		for(size_t r = 0; r < rows; ++r)
+		{
+			for(size_t c = 0; c < columns; ++c)
+			{
+				sum += adapters[c]->to_double(adapters[c]->parse(cells[r * columns + c]));
+			}
+		}
+		return sum;
+	});
+
+	run_cells("intelligent_cast_dispatch per cell", [&]()
+	{
+		double sum = 0;
+		intelligent_cast_value as_double = intelligent_cast_value::numeric(intelligent_cast_tag::double_);
+		for(size_t r = 0; r < rows; ++r)
+		{
+			for(size_t c = 0; c < columns; ++c)
+			{
+				const std::string& text = cells[r * columns + c];
+				intelligent_cast_value value = intelligent_cast_value::numeric(column_tags[c]);
+				intelligent_cast_dispatch(intelligent_cast_value::text(text.data(), text.data() + text.size()), value);
+				intelligent_cast_dispatch(value, as_double);
+				sum += as_double.get<double>();
+			}
+		}
+		return sum;
+	});
+
+	run_cells("converters looked up once per column", [&]()
+	{
+		intelligent_cast_converter parse[columns];
+		intelligent_cast_converter widen[columns];
+		for(size_t c = 0; c < columns; ++c)
+		{
+			parse[c] = intelligent_cast_dispatch_converter(intelligent_cast_tag::string_, column_tags[c]);
+			widen[c] = intelligent_cast_dispatch_converter(column_tags[c], intelligent_cast_tag::double_);
+		}
+		double sum = 0;
+		intelligent_cast_value as_double = intelligent_cast_value::numeric(intelligent_cast_tag::double_);
+		std::vector<intelligent_cast_value> row(columns);
+		for(size_t c = 0; c < columns; ++c)
+		{
+			row[c] = intelligent_cast_value::numeric(column_tags[c]);
+		}
+		for(size_t r = 0; r < rows; ++r)
+		{
+			for(size_t c = 0; c < columns; ++c)
+			{
+				const std::string& text = cells[r * columns + c];
+				parse[c](intelligent_cast_value::text(text.data(), text.data() + text.size()), row[c]);
+				widen[c](row[c], as_double);
+				sum += as_double.get<double>();
+			}
+		}
+		return sum;
+	});
+	return 0;
+}
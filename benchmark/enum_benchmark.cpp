@@ -0,0 +1,154 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <cstdio>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "../IntelligentCastEnum.h"
+#include "benchmark_harness.h"
+
+// requires C++14 (/std:c++14) for IntelligentCastEnum.h
+
+// status of an order as it arrives in a feed, such as "partially_filled"
+enum class order_status
+{
+	pending_new, new_order, partially_filled, filled, done_for_day, canceled, replaced, pending_cancel,
+	stopped, rejected, suspended, pending_replace, calculated, expired, accepted_for_bidding, pending_review
+};
+INTELLIGENT_CAST_ENUM(order_status,
+	"pending_new", "new_order", "partially_filled", "filled", "done_for_day", "canceled", "replaced", "pending_cancel",
+	"stopped", "rejected", "suspended", "pending_replace", "calculated", "expired", "accepted_for_bidding", "pending_review")
+
+const size_t count = 1 << 20;
+const size_t status_count = 16;
+
+std::vector<order_status> make_statuses()
+{
+	std::vector<order_status> statuses(count);
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < count; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		statuses[i] = static_cast<order_status>(state % status_count);
+	}
+	return statuses;
+}
+
+void report(const char* name, double ns, size_t mismatches, size_t checksum)
+{
+	printf("%-44s %8.2f ns/op %8u mismatches  (checksum %u)\n", name, ns, static_cast<unsigned int>(mismatches), static_cast<unsigned int>(checksum));
+}
+
+// text -> enum, mismatches counts the values which are not the value of the text
+template<typename Parse>
+void parse(const char* name, const std::vector<std::string>& texts, const std::vector<order_status>& expected, Parse parse_one)
+{
+	std::vector<order_status> statuses(count);
+	size_t checksum = 0;
+	const double ns = measure([&]()
+	{
+		size_t sum = 0;
+		for(size_t i = 0; i < count; ++i)
+		{
+			statuses[i] = parse_one(texts[i]);
+			sum += static_cast<size_t>(statuses[i]);
+		}
+		return sum;
+	}, checksum) / count;
+	size_t mismatches = 0;
+	for(size_t i = 0; i < count; ++i)
+	{
+		mismatches += statuses[i] != expected[i];
+	}
+	report(name, ns, mismatches, checksum);
+}
+
+// enum -> text, mismatches counts the texts which differ from the feed
+template<typename Format>
+void format(const char* name, const std::vector<std::string>& texts, const std::vector<order_status>& statuses, Format format_one)
+{
+	std::string text;
+	std::vector<size_t> offsets(count + 1);
+	size_t checksum = 0;
+	const double ns = measure([&]()
+	{
+		for(size_t i = 0; i < count; ++i)
+		{
+			offsets[i] = text.size();
+			format_one(text, statuses[i]);
+		}
+		offsets[count] = text.size();
+		return text.size();
+	}, checksum) / count;
+	size_t mismatches = 0;
+	for(size_t i = 0; i < count; ++i)
+	{
+		mismatches += text.compare(offsets[i], offsets[i + 1] - offsets[i], texts[i]) != 0;
+	}
+	report(name, ns, mismatches, checksum);
+}
+
+// a name followed by other characters is parsed like "12 " for numbers: trailing_characters, and consumed is the end of the name
+void check_trailing(const char* suffix, const std::vector<std::string>& texts, const std::vector<order_status>& expected)
+{
+	size_t mismatches = 0;
+	for(size_t i = 0; i < count; ++i)
+	{
+		const intelligent_cast_result<order_status> result = try_intelligent_cast<order_status>(texts[i] + suffix);
+		mismatches += result.error != intelligent_cast_errc::trailing_characters || result.value != expected[i] || result.consumed != texts[i].size();
+	}
+	printf("%-44s %8u mismatches of %u\n", (std::string("try_intelligent_cast of name + \"") + suffix + "\"").c_str(),
+		static_cast<unsigned int>(mismatches), static_cast<unsigned int>(count));
+}
+
+int main()
+{
+	const std::vector<order_status> statuses = make_statuses();
+	std::vector<std::string> texts(count);
+	for(size_t i = 0; i < count; ++i)
+	{
+		texts[i] = intelligent_cast_enum_name(statuses[i]);
+	}
+
+	// the tables which are written by hand when there is no registration
+	std::map<std::string, order_status> ordered;
+	std::unordered_map<std::string, order_status> unordered;
+	std::map<order_status, std::string> names;
+	for(size_t i = 0; i < status_count; ++i)
+	{
+		const order_status status = static_cast<order_status>(i);
+		ordered[intelligent_cast_enum_name(status)] = status;
+		unordered[intelligent_cast_enum_name(status)] = status;
+		names[status] = intelligent_cast_enum_name(status);
+	}
+
+	parse("std::map<std::string, order_status>", texts, statuses, [&](const std::string& text)
+	{
+		return ordered.find(text)->second;
+	});
+	parse("std::unordered_map<std::string, order_status>", texts, statuses, [&](const std::string& text)
+	{
+		return unordered.find(text)->second;
+	});
+	parse("intelligent_cast<order_status>", texts, statuses, [](const std::string& text)
+	{
+		return intelligent_cast<order_status>(text);
+	});
+
+	check_trailing(" ", texts, statuses);
+	check_trailing("x", texts, statuses);
+
+	format("std::map<order_status, std::string>", texts, statuses, [&](std::string& text, order_status status)
+	{
+		text += names.find(status)->second;
+	});
+	format("intelligent_cast_append of order_status", texts, statuses, [](std::string& text, order_status status)
+	{
+		intelligent_cast_append(text, status);
+	});
+	return 0;
+}
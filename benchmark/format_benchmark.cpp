@@ -0,0 +1,233 @@
+#include <cmath>
+#include <cstdio>
+#include <cwchar>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "../IntelligentCastFormat.h"
+#include "benchmark_harness.h"
+
+// format path used before the digit generation engine (snprintf into a stack buffer, then copied into a string)
+namespace legacy
+{
+	template<typename T>
+	std::string format(const T& src, const char* format)
+	{
+		char buf[255];
+		snprintf(buf, sizeof(buf)/sizeof(char), format, src);
+		return std::string(buf);
+	}
+	template<typename T>
+	std::wstring format(const T& src, const wchar_t* format)
+	{
+		wchar_t buf[255];
+		swprintf(buf, sizeof(buf)/sizeof(wchar_t), format, src);
+		return std::wstring(buf);
+	}
+}
+
+// values are generated with a fixed seed so that every run formats the same input
+template<typename T>
+std::vector<T> make_values(size_t count, unsigned long long range)
+{
+	std::vector<T> values(count);
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < count; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		values[i] = static_cast<T>(range ? state % range : state);
+	}
+	return values;
+}
+
+// doubles with random significand spread over [1e-20, 1e20)
+std::vector<double> make_doubles(size_t count)
+{
+	const std::vector<unsigned long long> bits = make_values<unsigned long long>(count, 0);
+	std::vector<double> values(count);
+	for(size_t i = 0; i < count; ++i)
+	{
+		const double fraction = static_cast<double>(bits[i] >> 11) / 9007199254740992.0;
+		values[i] = fraction * std::pow(10.0, static_cast<int>(bits[i] % 40) - 20);
+	}
+	return values;
+}
+
+template<typename StrType, typename T, typename CharT>
+void compare(const char* type_name, const std::vector<T>& values, const CharT* printf_format)
+{
+	char name[128];
+
+	snprintf(name, sizeof(name), "%s legacy sprintf", type_name);
+	run(name, values.size(), [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < values.size(); ++i) length += legacy::format(values[i], printf_format).size();
+		return length;
+	});
+
+	snprintf(name, sizeof(name), "%s intelligent_cast", type_name);
+	run(name, values.size(), [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < values.size(); ++i) length += intelligent_cast<StrType>(values[i]).size();
+		return length;
+	});
+
+	// one buffer is reused for the whole run, as when a record is built field by field
+	snprintf(name, sizeof(name), "%s intelligent_cast_append", type_name);
+	StrType buffer;
+	run(name, values.size(), [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < values.size(); ++i)
+		{
+			buffer.clear();
+			length += intelligent_cast_append(buffer, values[i]).size();
+		}
+		return length;
+	});
+
+	// the text is held on the stack, and the allocator is never used
+	snprintf(name, sizeof(name), "%s intelligent_cast small_text", type_name);
+	run(name, values.size(), [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < values.size(); ++i) length += intelligent_cast<small_text<T, typename StrType::value_type> >(values[i]).size();
+		return length;
+	});
+}
+
+// format policy against the printf format which writes the same text
+template<typename Format, typename T>
+void compare_format(const char* type_name, const std::vector<T>& values, const char* printf_format)
+{
+	char name[128];
+
+	snprintf(name, sizeof(name), "%s legacy sprintf", type_name);
+	run(name, values.size(), [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < values.size(); ++i) length += legacy::format(values[i], printf_format).size();
+		return length;
+	});
+
+	snprintf(name, sizeof(name), "%s intelligent_cast", type_name);
+	run(name, values.size(), [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < values.size(); ++i) length += intelligent_cast<std::string, Format>(values[i]).size();
+		return length;
+	});
+
+	snprintf(name, sizeof(name), "%s intelligent_cast_append", type_name);
+	std::string buffer;
+	run(name, values.size(), [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < values.size(); ++i)
+		{
+			buffer.clear();
+			length += intelligent_cast_append<Format>(buffer, values[i]).size();
+		}
+		return length;
+	});
+}
+
+// powers of ten and their neighbours, where the shortest text is a single 1 and the exact value may be just below it
+template<typename T>
+std::vector<T> make_powers_of_ten()
+{
+	std::vector<T> values;
+	for(int exponent = std::numeric_limits<T>::min_exponent10 - std::numeric_limits<T>::digits10; exponent <= std::numeric_limits<T>::max_exponent10; ++exponent)
+	{
+		char literal[16];
+		snprintf(literal, sizeof(literal), "1e%d", exponent);
+		const T power = static_cast<T>(intelligent_cast<T>(literal));
+		values.push_back(std::nextafter(power, static_cast<T>(0)));
+		values.push_back(power);
+		values.push_back(std::nextafter(power, std::numeric_limits<T>::infinity()));
+	}
+	return values;
+}
+
+// the text of format policy must be the same as printf, mismatches are counted
+template<typename Format, typename T>
+void check_format(const char* type_name, const std::vector<T>& values, const char* printf_format)
+{
+	size_t mismatches = 0;
+	char expected[512];
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		snprintf(expected, sizeof(expected), printf_format, static_cast<double>(values[i]));
+		mismatches += intelligent_cast<std::string, Format>(values[i]) != expected;
+	}
+	printf("%-48s %8u mismatches of %u\n", type_name, static_cast<unsigned int>(mismatches), static_cast<unsigned int>(values.size()));
+}
+
+// prices and measurements with a few decimal places, as written by fixed width reports
+std::vector<double> make_amounts(size_t count)
+{
+	const std::vector<unsigned long long> bits = make_values<unsigned long long>(count, 0);
+	std::vector<double> values(count);
+	for(size_t i = 0; i < count; ++i)
+	{
+		values[i] = static_cast<double>(bits[i] % 100000000) / std::pow(10.0, static_cast<int>(bits[i] % 5));
+	}
+	return values;
+}
+
+int main()
+{
+	const size_t count = 1000000;
+
+	const std::vector<int> small_ints = make_values<int>(count, 10000);
+	const std::vector<int> ints = make_values<int>(count, 0);
+	const std::vector<unsigned long long> ulonglongs = make_values<unsigned long long>(count, 0);
+	const std::vector<double> doubles = make_doubles(count);
+	const std::vector<float> floats(doubles.begin(), doubles.end());
+
+	compare<std::string>("int [0, 10000) -> string", small_ints, "%d");
+	// texts of small integers are referred in the constant table, nothing is converted nor copied
+	run("int [0, 10000) -> c_str and length (small integer table)", small_ints.size(), [&]() -> size_t
+	{
+		size_t length = 0;
+		for(size_t i = 0; i < small_ints.size(); ++i)
+		{
+			length += intelligent_cast_small_integer<char>::length(small_ints[i]) + static_cast<size_t>(*intelligent_cast_small_integer<char>::c_str(small_ints[i]) - '0');
+		}
+		return length;
+	});
+	compare<std::string>("int full range -> string", ints, "%d");
+	compare<std::string>("unsigned long long -> string", ulonglongs, "%llu");
+	compare<std::wstring>("int full range -> wstring", ints, L"%d");
+	compare<std::wstring>("unsigned long long -> wstring", ulonglongs, L"%llu");
+	compare<std::string>("double -> string (%g, lossy)", doubles, "%g");
+	compare<std::string>("double -> string (%.17g)", doubles, "%.17g");
+	compare<std::string>("float -> string (%.9g)", floats, "%.9g");
+	compare<std::wstring>("double -> wstring (%.17g)", doubles, L"%.17g");
+
+	const std::vector<double> amounts = make_amounts(count);
+	compare_format<intelligent_cast_fmt::hex>("int full range -> string (hex)", ints, "%x");
+	compare_format<intelligent_cast_fmt::zero_pad<10> >("int [0, 10000) -> string (zero_pad<10>)", small_ints, "%010d");
+	compare_format<intelligent_cast_fmt::fixed<3> >("amount -> string (fixed<3>)", amounts, "%.3f");
+	compare_format<intelligent_cast_fmt::fixed<3> >("double -> string (fixed<3>)", doubles, "%.3f");
+	compare_format<intelligent_cast_fmt::scientific<6> >("double -> string (scientific<6>)", doubles, "%.6e");
+
+	const std::vector<double> double_powers = make_powers_of_ten<double>();
+	std::vector<float> float_powers = make_powers_of_ten<float>();
+	float_powers.push_back(9.9492191e-44f);
+	check_format<intelligent_cast_fmt::scientific<6> >("double (scientific<6>) against %.6e", doubles, "%.6e");
+	check_format<intelligent_cast_fmt::fixed<3> >("double (fixed<3>) against %.3f", doubles, "%.3f");
+	check_format<intelligent_cast_fmt::scientific<15> >("powers of ten (scientific<15>) against %.15e", double_powers, "%.15e");
+	check_format<intelligent_cast_fmt::scientific<0> >("powers of ten (scientific<0>) against %.0e", double_powers, "%.0e");
+	check_format<intelligent_cast_fmt::fixed<20> >("powers of ten (fixed<20>) against %.20f", double_powers, "%.20f");
+	check_format<intelligent_cast_fmt::scientific<1> >("float powers of ten (scientific<1>) against %.1e", float_powers, "%.1e");
+	check_format<intelligent_cast_fmt::scientific<8> >("float powers of ten (scientific<8>) against %.8e", float_powers, "%.8e");
+
+	return 0;
+}
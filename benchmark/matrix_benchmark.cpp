@@ -0,0 +1,507 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "allocation_counter.h"
+#include "benchmark_harness.h"
+
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L
+#include <charconv>
+#define MATRIX_BENCHMARK_HAS_CHARCONV
+#endif
+// floating point to_chars / from_chars came later than integral ones
+#if defined(MATRIX_BENCHMARK_HAS_CHARCONV) && defined(__cpp_lib_to_chars)
+#define MATRIX_BENCHMARK_HAS_FLOATING_CHARCONV
+#endif
+
+// distributions of input values
+enum distribution
+{
+	small_ints,			// [0, 10000), or the positive range of narrower types
+	full_range,			// every bit pattern of integral type
+	random_doubles,		// random significand spread over [1e-20, 1e20)
+	long_strings		// 1024 characters, one in ten is not ASCII
+};
+
+const char* distribution_name(distribution d)
+{
+	switch(d)
+	{
+	case small_ints:		return "small";
+	case full_range:		return "full";
+	case random_doubles:	return "random";
+	default:				return "long";
+	}
+}
+
+// names of the types in the README table
+template<typename T> struct type_name;
+#define MATRIX_BENCHMARK_TYPE_NAME(type) template<> struct type_name<type> { static const char* get() { return #type; } };
+MATRIX_BENCHMARK_TYPE_NAME(char)
+MATRIX_BENCHMARK_TYPE_NAME(unsigned char)
+MATRIX_BENCHMARK_TYPE_NAME(short)
+MATRIX_BENCHMARK_TYPE_NAME(unsigned short)
+MATRIX_BENCHMARK_TYPE_NAME(int)
+MATRIX_BENCHMARK_TYPE_NAME(unsigned int)
+MATRIX_BENCHMARK_TYPE_NAME(long)
+MATRIX_BENCHMARK_TYPE_NAME(unsigned long)
+MATRIX_BENCHMARK_TYPE_NAME(long long)
+MATRIX_BENCHMARK_TYPE_NAME(unsigned long long)
+MATRIX_BENCHMARK_TYPE_NAME(float)
+MATRIX_BENCHMARK_TYPE_NAME(double)
+MATRIX_BENCHMARK_TYPE_NAME(std::string)
+MATRIX_BENCHMARK_TYPE_NAME(std::wstring)
+MATRIX_BENCHMARK_TYPE_NAME(const char*)
+MATRIX_BENCHMARK_TYPE_NAME(const wchar_t*)
+#undef MATRIX_BENCHMARK_TYPE_NAME
+
+template<typename T>
+struct is_text : std::false_type {};
+template<>
+struct is_text<std::string> : std::true_type {};
+template<>
+struct is_text<std::wstring> : std::true_type {};
+
+// values are generated with a fixed seed so that every run converts the same input
+class xorshift
+{
+public:
+	xorshift() : state_(88172645463325252ull) {}
+	unsigned long long operator()()
+	{
+		state_ ^= state_ << 13;
+		state_ ^= state_ >> 7;
+		state_ ^= state_ << 17;
+		return state_;
+	}
+private:
+	unsigned long long state_;
+};
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value, std::vector<T> >::type
+make_numbers(size_t count, distribution d)
+{
+	xorshift random;
+	std::vector<T> values(count);
+	const unsigned long long max = static_cast<unsigned long long>(std::numeric_limits<T>::max());
+	const unsigned long long range = max < 10000ull ? max + 1 : 10000ull;
+	for(size_t i = 0; i < count; ++i)
+	{
+		const unsigned long long bits = random();
+		if(d == small_ints)
+		{
+			values[i] = static_cast<T>(bits % range);
+		}
+		else
+		{
+			std::memcpy(&values[i], &bits, sizeof(T));
+		}
+	}
+	return values;
+}
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value, std::vector<T> >::type
+make_numbers(size_t count, distribution)
+{
+	xorshift random;
+	std::vector<T> values(count);
+	for(size_t i = 0; i < count; ++i)
+	{
+		const unsigned long long bits = random();
+		const double fraction = static_cast<double>(bits >> 11) / 9007199254740992.0;
+		values[i] = static_cast<T>(fraction * std::pow(10.0, static_cast<int>(bits % 40) - 20));
+	}
+	return values;
+}
+
+template<typename StrType>
+std::vector<StrType> make_long_strings(size_t count)
+{
+	xorshift random;
+	std::vector<StrType> values(count);
+	std::string text;
+	for(size_t i = 0; i < count; ++i)
+	{
+		text.clear();
+		for(size_t j = 0; j < 1024; ++j)
+		{
+			const unsigned long long bits = random();
+			if(bits % 10 == 0)
+			{
+				text += "\xC3\xA9";
+			}
+			else
+			{
+				text += static_cast<char>('a' + bits % 26);
+			}
+		}
+		values[i] = intelligent_cast<StrType>(text);
+	}
+	return values;
+}
+
+template<typename StrType, typename T>
+std::vector<StrType> to_text(const std::vector<T>& values)
+{
+	std::vector<StrType> texts(values.size());
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		texts[i] = intelligent_cast<StrType>(values[i]);
+	}
+	return texts;
+}
+
+// inputs of From for the conversion to To: text of To values when From is a string
+template<typename From, typename To>
+struct input_maker
+{
+	static std::vector<distribution> distributions()
+	{
+		std::vector<distribution> result;
+		if(std::is_floating_point<From>::value)
+		{
+			result.push_back(random_doubles);
+		}
+		else
+		{
+			result.push_back(small_ints);
+			result.push_back(full_range);
+		}
+		return result;
+	}
+	static std::vector<From> make(size_t count, distribution d)	{ return make_numbers<From>(count, d); }
+};
+template<typename To>
+struct input_maker<std::string, To> : input_maker<To, std::string>
+{
+	static std::vector<std::string> make(size_t count, distribution d)	{ return to_text<std::string>(make_numbers<To>(count, d)); }
+};
+template<typename To>
+struct input_maker<std::wstring, To> : input_maker<To, std::wstring>
+{
+	static std::vector<std::wstring> make(size_t count, distribution d)	{ return to_text<std::wstring>(make_numbers<To>(count, d)); }
+};
+template<typename StrType>
+struct text_input_maker
+{
+	static std::vector<distribution> distributions()					{ return std::vector<distribution>(1, long_strings); }
+	static std::vector<StrType> make(size_t count, distribution)		{ return make_long_strings<StrType>(count); }
+};
+template<> struct input_maker<std::string, std::string> : text_input_maker<std::string> {};
+template<> struct input_maker<std::string, std::wstring> : text_input_maker<std::string> {};
+template<> struct input_maker<std::wstring, std::string> : text_input_maker<std::wstring> {};
+template<> struct input_maker<std::wstring, std::wstring> : text_input_maker<std::wstring> {};
+
+// null terminated character arrays are only converted from, they point to the strings made for std::basic_string
+template<typename CharT, typename To>
+struct pointer_input_maker : input_maker<std::basic_string<CharT>, To>
+{
+	static std::vector<const CharT*> make(size_t count, distribution d)
+	{
+		// the strings are kept until the next inputs are made, after the conversions of these inputs finish
+		static std::vector<std::basic_string<CharT> > texts;
+		texts = input_maker<std::basic_string<CharT>, To>::make(count, d);
+		std::vector<const CharT*> pointers(texts.size());
+		for(size_t i = 0; i < texts.size(); ++i)
+		{
+			pointers[i] = texts[i].c_str();
+		}
+		return pointers;
+	}
+};
+template<typename To> struct input_maker<const char*, To> : pointer_input_maker<char, To> {};
+template<typename To> struct input_maker<const wchar_t*, To> : pointer_input_maker<wchar_t, To> {};
+
+// value folded into the checksum, so that no conversion is optimized away
+template<typename T>
+unsigned long long to_checksum(const T& value)		{ return static_cast<unsigned long long>(value); }
+inline unsigned long long to_checksum(const std::string& value)		{ return value.size(); }
+inline unsigned long long to_checksum(const std::wstring& value)	{ return value.size(); }
+
+unsigned long long checksum = 0;
+
+template<typename From, typename Func>
+double run(const char* from, const char* to, distribution d, const char* method, const std::vector<From>& inputs, Func func)
+{
+	const int repeat = 5;
+	const size_t count_before = allocation::count;
+	const size_t bytes_before = allocation::bytes;
+	const double ns = measure([&]()
+	{
+		for(int r = 0; r < repeat; ++r)
+		{
+			for(size_t i = 0; i < inputs.size(); ++i)
+			{
+				checksum += to_checksum(func(inputs[i]));
+			}
+		}
+	});
+	const double ops = static_cast<double>(inputs.size() * repeat);
+	const double allocations = (allocation::count - count_before) / ops;
+	printf("%-20s %-20s %-7s %-18s %9.2f %10.2f %9.3f\n", from, to, distribution_name(d), method,
+		ns / ops,
+		(allocation::bytes - bytes_before) / ops,
+		allocations);
+	return allocations;
+}
+
+// printf and scanf conversion specifications
+template<typename T> struct printf_spec;
+#define MATRIX_BENCHMARK_SPEC(type, print, scan) \
+	template<> struct printf_spec<type> \
+	{ \
+		static const char* print_format()		{ return print; } \
+		static const wchar_t* wprint_format()	{ return L##print; } \
+		static const char* scan_format()		{ return scan; } \
+		static const wchar_t* wscan_format()	{ return L##scan; } \
+	};
+MATRIX_BENCHMARK_SPEC(char, "%d", "%hhd")
+MATRIX_BENCHMARK_SPEC(unsigned char, "%u", "%hhu")
+MATRIX_BENCHMARK_SPEC(short, "%hd", "%hd")
+MATRIX_BENCHMARK_SPEC(unsigned short, "%hu", "%hu")
+MATRIX_BENCHMARK_SPEC(int, "%d", "%d")
+MATRIX_BENCHMARK_SPEC(unsigned int, "%u", "%u")
+MATRIX_BENCHMARK_SPEC(long, "%ld", "%ld")
+MATRIX_BENCHMARK_SPEC(unsigned long, "%lu", "%lu")
+MATRIX_BENCHMARK_SPEC(long long, "%lld", "%lld")
+MATRIX_BENCHMARK_SPEC(unsigned long long, "%llu", "%llu")
+MATRIX_BENCHMARK_SPEC(float, "%.9g", "%g")
+MATRIX_BENCHMARK_SPEC(double, "%.17g", "%lg")
+#undef MATRIX_BENCHMARK_SPEC
+
+// char types are printed as numbers by stream and promoted by printf
+template<typename T>
+struct promoted
+{
+	typedef decltype(+T()) type;
+};
+
+// std::sto* function which covers T
+template<typename T, typename StrType>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, T>::type
+sto(const StrType& text)	{ return static_cast<T>(sizeof(T) <= sizeof(long) ? std::stol(text) : std::stoll(text)); }
+template<typename T, typename StrType>
+typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, T>::type
+sto(const StrType& text)	{ return static_cast<T>(sizeof(T) <= sizeof(unsigned long) ? std::stoul(text) : std::stoull(text)); }
+template<typename T, typename StrType>
+typename std::enable_if<std::is_floating_point<T>::value, T>::type
+sto(const StrType& text)	{ return static_cast<T>(sizeof(T) == sizeof(float) ? std::stof(text) : std::stod(text)); }
+
+// comparison functions of the standard library for each kind of conversion
+template<typename From, typename To,
+	bool NumberToText = std::is_arithmetic<From>::value && is_text<To>::value,
+	bool TextToNumber = is_text<From>::value && std::is_arithmetic<To>::value>
+struct baselines
+{
+	static void run_all(distribution, const std::vector<From>&)
+	{
+	}
+};
+
+// number -> text
+template<typename From, typename To>
+struct baselines<From, To, true, false>
+{
+	typedef typename To::value_type char_type;
+
+	static void run_all(distribution d, const std::vector<From>& inputs)
+	{
+		const char* from = type_name<From>::get();
+		const char* to = type_name<To>::get();
+
+		run(from, to, d, "snprintf", inputs, [](const From& value) { return print(value, char_type()); });
+		run(from, to, d, "std::to_string", inputs, [](const From& value) { return to_string(value, char_type()); });
+		run(from, to, d, "std::stringstream", inputs, [](const From& value) -> To
+		{
+			std::basic_ostringstream<char_type> stream;
+			stream.precision(std::numeric_limits<From>::max_digits10);
+			stream << static_cast<typename promoted<From>::type>(value);
+			return stream.str();
+		});
+		to_chars(d, inputs, char_type());
+	}
+	static std::string print(const From& value, char)
+	{
+		char buf[64];
+		return std::string(buf, snprintf(buf, sizeof(buf), printf_spec<From>::print_format(), static_cast<typename promoted<From>::type>(value)));
+	}
+	static std::wstring print(const From& value, wchar_t)
+	{
+		wchar_t buf[64];
+		return std::wstring(buf, swprintf(buf, sizeof(buf) / sizeof(wchar_t), printf_spec<From>::wprint_format(), static_cast<typename promoted<From>::type>(value)));
+	}
+	static std::string to_string(const From& value, char)		{ return std::to_string(static_cast<typename promoted<From>::type>(value)); }
+	static std::wstring to_string(const From& value, wchar_t)	{ return std::to_wstring(static_cast<typename promoted<From>::type>(value)); }
+
+	static void to_chars(distribution d, const std::vector<From>& inputs, char)
+	{
+#if defined(MATRIX_BENCHMARK_HAS_CHARCONV)
+		if(std::is_integral<From>::value || is_floating_to_chars_supported())
+		{
+			run(type_name<From>::get(), type_name<To>::get(), d, "std::to_chars", inputs, [](const From& value) -> std::string
+			{
+				char buf[64];
+				return std::string(buf, std::to_chars(buf, buf + sizeof(buf), value).ptr);
+			});
+		}
+#else
+		(void)d;
+		(void)inputs;
+#endif
+	}
+	static void to_chars(distribution, const std::vector<From>&, wchar_t)
+	{
+	}
+	static bool is_floating_to_chars_supported()
+	{
+#if defined(MATRIX_BENCHMARK_HAS_FLOATING_CHARCONV)
+		return true;
+#else
+		return false;
+#endif
+	}
+};
+
+// text -> number
+template<typename From, typename To>
+struct baselines<From, To, false, true>
+{
+	typedef typename From::value_type char_type;
+
+	static void run_all(distribution d, const std::vector<From>& inputs)
+	{
+		const char* from = type_name<From>::get();
+		const char* to = type_name<To>::get();
+
+		run(from, to, d, "sscanf", inputs, [](const From& text) { return scan(text); });
+		run(from, to, d, "std::sto*", inputs, [](const From& text) { return sto<To>(text); });
+		run(from, to, d, "std::stringstream", inputs, [](const From& text) -> To
+		{
+			std::basic_istringstream<char_type> stream(text);
+			typename promoted<To>::type value = 0;
+			stream >> value;
+			return static_cast<To>(value);
+		});
+		from_chars(d, inputs, char_type());
+	}
+	static To scan(const std::string& text)
+	{
+		To value = 0;
+		sscanf(text.c_str(), printf_spec<To>::scan_format(), &value);
+		return value;
+	}
+	static To scan(const std::wstring& text)
+	{
+		To value = 0;
+		swscanf(text.c_str(), printf_spec<To>::wscan_format(), &value);
+		return value;
+	}
+	static void from_chars(distribution d, const std::vector<From>& inputs, char)
+	{
+#if defined(MATRIX_BENCHMARK_HAS_CHARCONV)
+#if !defined(MATRIX_BENCHMARK_HAS_FLOATING_CHARCONV)
+		if(std::is_floating_point<To>::value)
+		{
+			return;
+		}
+#endif
+		run(type_name<From>::get(), type_name<To>::get(), d, "std::from_chars", inputs, [](const std::string& text) -> To
+		{
+			To value = 0;
+			from_chars_impl(text.data(), text.data() + text.size(), value);
+			return value;
+		});
+#else
+		(void)d;
+		(void)inputs;
+#endif
+	}
+	static void from_chars(distribution, const std::vector<From>&, wchar_t)
+	{
+	}
+#if defined(MATRIX_BENCHMARK_HAS_CHARCONV)
+	template<typename T>
+	static typename std::enable_if<std::is_integral<T>::value>::type from_chars_impl(const char* first, const char* last, T& value)
+	{
+		std::from_chars(first, last, value);
+	}
+	template<typename T>
+	static typename std::enable_if<std::is_floating_point<T>::value>::type from_chars_impl(const char* first, const char* last, T& value)
+	{
+#if defined(MATRIX_BENCHMARK_HAS_FLOATING_CHARCONV)
+		std::from_chars(first, last, value);
+#else
+		value = static_cast<T>(first != last);
+#endif
+	}
+#endif
+};
+
+// intelligent_cast of every pair must allocate at most once(only the result), the pairs which do not are reported at the end
+std::vector<std::string> over_one_allocation;
+
+template<typename From, typename To>
+void run_pair()
+{
+	const size_t count = 20000;
+	const std::vector<distribution> distributions = input_maker<From, To>::distributions();
+	for(size_t i = 0; i < distributions.size(); ++i)
+	{
+		const std::vector<From> inputs = input_maker<From, To>::make(count, distributions[i]);
+		const double allocations = run(type_name<From>::get(), type_name<To>::get(), distributions[i], "intelligent_cast", inputs,
+			[](const From& value) -> To { return intelligent_cast<To>(value); });
+		if(allocations > 1.0)
+		{
+			over_one_allocation.push_back(std::string(type_name<From>::get()) + " -> " + type_name<To>::get() + " (" + distribution_name(distributions[i]) + ")");
+		}
+		baselines<From, To>::run_all(distributions[i], inputs);
+	}
+}
+
+template<typename... Types>
+struct type_list
+{
+};
+
+template<typename From, typename... To>
+void run_from(type_list<To...>)
+{
+	const int expand[] = { 0, (run_pair<From, To>(), 0)... };
+	(void)expand;
+}
+
+template<typename... From>
+void run_matrix(type_list<From...> types)
+{
+	const int expand[] = { 0, (run_from<From>(types), 0)... };
+	(void)expand;
+}
+
+int main()
+{
+	printf("%-20s %-20s %-7s %-18s %9s %10s %9s\n", "from", "to", "input", "method", "ns/op", "bytes/op", "allocs/op");
+
+	typedef type_list<
+		char, unsigned char, short, unsigned short, int, unsigned int, long, unsigned long,
+		long long, unsigned long long, float, double, std::string, std::wstring
+	> types;
+	run_matrix(types());
+	run_from<const char*>(types());
+	run_from<const wchar_t*>(types());
+
+	printf("checksum %llu\n", checksum);
+	printf("intelligent_cast pairs over one allocation per conversion: %u\n", static_cast<unsigned int>(over_one_allocation.size()));
+	for(size_t i = 0; i < over_one_allocation.size(); ++i)
+	{
+		printf("  %s\n", over_one_allocation[i].c_str());
+	}
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../IntelligentCastParallel.h"
+#include "benchmark_harness.h"
+
+// a wide string dump and a numeric column, converted by pools of 1 to all hardware threads
+const size_t wide_characters = 64 << 20;
+const size_t column_values = 16 << 20;
+
+std::wstring make_wide_text()
+{
+	std::wstring text(wide_characters, L'a');
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < text.size(); ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		// one in eight characters is not ASCII
+		text[i] = state % 8 == 0 ? static_cast<wchar_t>(0x3042 + state % 64) : static_cast<wchar_t>('a' + state % 26);
+	}
+	return text;
+}
+
+std::vector<double> make_column()
+{
+	std::vector<double> values(column_values);
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		values[i] = static_cast<double>(i * 7919 % 1000003) / 128.0;
+	}
+	return values;
+}
+
+int main()
+{
+	const std::wstring wide = make_wide_text();
+	const std::vector<double> values = make_column();
+	std::vector<size_t> offsets(values.size() + 1);
+	std::vector<double> parsed(values.size());
+
+	const unsigned int max_threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+	std::vector<unsigned int> thread_counts;
+	for(unsigned int threads = 1; threads < max_threads; threads *= 2)
+	{
+		thread_counts.push_back(threads);
+	}
+	thread_counts.push_back(max_threads);
+
+	printf("%u wide characters to UTF-8, %u doubles to text and back\n\n", static_cast<unsigned int>(wide_characters), static_cast<unsigned int>(column_values));
+	printf("%8s %14s %9s %14s %9s %14s %9s\n", "threads", "transcode ms", "speedup", "format ms", "speedup", "parse ms", "speedup");
+	double single[3] = { 0, 0, 0 };
+	size_t checksum = 0;
+	for(size_t i = 0; i < thread_counts.size(); ++i)
+	{
+		intelligent_cast_thread_pool pool(thread_counts[i]);
+		std::string utf8;
+		std::string text;
+		size_t errors = 0;
+		const double ms[3] =
+		{
+			measure([&]() { utf8 = intelligent_cast_parallel<std::string>(wide, pool); }) / 1e6,
+			measure([&]() { intelligent_cast_format_parallel(values.data(), values.size(), text, offsets.data(), pool); }) / 1e6,
+			measure([&]() { errors = intelligent_cast_parse_parallel(text.data(), offsets.data(), values.size(), parsed.data(), pool); }) / 1e6
+		};
+		if(i == 0)
+		{
+			single[0] = ms[0];
+			single[1] = ms[1];
+			single[2] = ms[2];
+		}
+		checksum += utf8.size() + text.size() + errors + (parsed == values ? 0 : 1);
+		printf("%8u %14.1f %8.2fx %14.1f %8.2fx %14.1f %8.2fx\n", thread_counts[i],
+			ms[0], single[0] / ms[0], ms[1], single[1] / ms[1], ms[2], single[2] / ms[2]);
+	}
+	printf("\nchecksum %u\n", static_cast<unsigned int>(checksum));
+	return 0;
+}
@@ -0,0 +1,135 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "benchmark_harness.h"
+
+// parse path used before the range parser (the input is copied into a string, then parsed by the C runtime)
+namespace legacy
+{
+	inline int to_int(const char* src)							{ return atoi(std::string(src).c_str()); }
+	inline long long to_longlong(const char* src)				{ return atoll(std::string(src).c_str()); }
+	inline unsigned long long to_ulonglong(const char* src)		{ return strtoull(std::string(src).c_str(), NULL, 10); }
+	inline int to_int(const wchar_t* src)						{ return static_cast<int>(wcstol(std::wstring(src).c_str(), NULL, 10)); }
+	inline double to_double(const char* src)					{ return atof(std::string(src).c_str()); }
+	inline double to_double(const wchar_t* src)					{ return wcstod(std::wstring(src).c_str(), NULL); }
+}
+
+// values are generated with a fixed seed so that every run parses the same input
+template<typename T>
+std::vector<T> make_values(size_t count, unsigned long long range)
+{
+	std::vector<T> values(count);
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < count; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		values[i] = static_cast<T>(range ? state % range : state);
+	}
+	return values;
+}
+
+// doubles with random significand spread over [1e-20, 1e20)
+std::vector<double> make_doubles(size_t count)
+{
+	const std::vector<unsigned long long> bits = make_values<unsigned long long>(count, 0);
+	std::vector<double> values(count);
+	for(size_t i = 0; i < count; ++i)
+	{
+		const double fraction = static_cast<double>(bits[i] >> 11) / 9007199254740992.0;
+		values[i] = fraction * std::pow(10.0, static_cast<int>(bits[i] % 40) - 20);
+	}
+	return values;
+}
+
+// fields are NUL terminated and padded with leading spaces so that the legacy path can not rely on small string optimization
+template<typename StrType, typename T>
+std::vector<StrType> make_fields(const std::vector<T>& values)
+{
+	std::vector<StrType> fields(values.size());
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		const StrType digits = intelligent_cast<StrType>(values[i]);
+		fields[i] = StrType(32 - digits.size(), static_cast<typename StrType::value_type>(' ')) + digits;
+	}
+	return fields;
+}
+
+// floating point values are summed by their bits, so that a single wrong rounding changes the checksum
+template<typename T>
+unsigned long long to_checksum(T value)
+{
+	return static_cast<unsigned long long>(value);
+}
+inline unsigned long long to_checksum(double value)
+{
+	unsigned long long bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+template<typename T, typename StrType, typename Legacy>
+void compare(const char* type_name, const std::vector<StrType>& fields, Legacy legacy_parse)
+{
+	char name[128];
+
+	snprintf(name, sizeof(name), "%s legacy", type_name);
+	run(name, fields.size(), [&]() -> unsigned long long
+	{
+		unsigned long long sum = 0;
+		for(size_t i = 0; i < fields.size(); ++i) sum += to_checksum(legacy_parse(fields[i].c_str()));
+		return sum;
+	});
+
+	snprintf(name, sizeof(name), "%s intelligent_cast", type_name);
+	run(name, fields.size(), [&]() -> unsigned long long
+	{
+		unsigned long long sum = 0;
+		for(size_t i = 0; i < fields.size(); ++i) sum += to_checksum(intelligent_cast<T>(fields[i].c_str()));
+		return sum;
+	});
+}
+
+int main()
+{
+	const size_t count = 1000000;
+
+	const std::vector<std::string> ints = make_fields<std::string>(make_values<int>(count, 0));
+	const std::vector<std::string> longlongs = make_fields<std::string>(make_values<long long>(count, 0));
+	const std::vector<std::string> ulonglongs = make_fields<std::string>(make_values<unsigned long long>(count, 0));
+	const std::vector<std::wstring> wints = make_fields<std::wstring>(make_values<int>(count, 0));
+	const std::vector<std::string> doubles = make_fields<std::string>(make_doubles(count));
+	const std::vector<std::wstring> wdoubles = make_fields<std::wstring>(make_doubles(count));
+
+	compare<int>("const char* -> int", ints, [](const char* s) { return legacy::to_int(s); });
+	compare<long long>("const char* -> long long", longlongs, [](const char* s) { return legacy::to_longlong(s); });
+	compare<unsigned long long>("const char* -> unsigned long long", ulonglongs, [](const char* s) { return legacy::to_ulonglong(s); });
+	compare<int>("const wchar_t* -> int", wints, [](const wchar_t* s) { return legacy::to_int(s); });
+	compare<double>("const char* -> double", doubles, [](const char* s) { return legacy::to_double(s); });
+	compare<double>("const wchar_t* -> double", wdoubles, [](const wchar_t* s) { return legacy::to_double(s); });
+
+	// fields of one buffer are parsed in place by the range overload
+	std::string buffer;
+	std::vector<size_t> offsets(1, 0);
+	for(size_t i = 0; i < ints.size(); ++i)
+	{
+		buffer += ints[i];
+		offsets.push_back(buffer.size());
+	}
+	run("char range -> int intelligent_cast", count, [&]() -> unsigned long long
+	{
+		unsigned long long sum = 0;
+		const char* data = buffer.data();
+		for(size_t i = 0; i < count; ++i) sum += static_cast<unsigned long long>(intelligent_cast<int>(data + offsets[i], data + offsets[i + 1]));
+		return sum;
+	});
+
+	return 0;
+}
@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "../IntelligentCastReader.h"
+#include "benchmark_harness.h"
+
+// records of "int,double,long long" generated with a fixed seed
+std::string make_csv(size_t count)
+{
+	std::string csv;
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < count; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		intelligent_cast_append(csv, static_cast<int>(state));
+		csv += ',';
+		intelligent_cast_append(csv, static_cast<double>(state % 1000000) / 1000);
+		csv += ',';
+		intelligent_cast_append(csv, static_cast<long long>(state >> 3));
+		csv += '\n';
+	}
+	return csv;
+}
+
+int main()
+{
+	const size_t count = 1000000;
+	const std::string csv = make_csv(count);
+
+	// each line is read into a string, and split into strings for intelligent_cast
+	run("getline + intelligent_cast", count, [&]() -> unsigned long long
+	{
+		std::istringstream stream(csv);
+		std::vector<int> a;
+		std::vector<double> b;
+		std::vector<long long> c;
+		std::string line, field;
+		while(std::getline(stream, line))
+		{
+			std::istringstream fields(line);
+			std::getline(fields, field, ',');
+			a.push_back(intelligent_cast<int>(field));
+			std::getline(fields, field, ',');
+			b.push_back(intelligent_cast<double>(field));
+			std::getline(fields, field, ',');
+			c.push_back(intelligent_cast<long long>(field));
+		}
+		return a.size() + static_cast<unsigned long long>(c.back());
+	}, 5, "record");
+
+	run("intelligent_cast_reader (stream)", count, [&]() -> unsigned long long
+	{
+		std::istringstream stream(csv);
+		intelligent_cast_reader<char> reader(stream);
+		std::vector<int> a;
+		std::vector<double> b;
+		std::vector<long long> c;
+		intelligent_cast_read_columns(reader, a, b, c);
+		return a.size() + static_cast<unsigned long long>(c.back());
+	}, 5, "record");
+
+	// the same as reading intelligent_cast_mapped_file
+	run("intelligent_cast_reader (memory)", count, [&]() -> unsigned long long
+	{
+		intelligent_cast_reader<char> reader(csv.data(), csv.data() + csv.size());
+		std::vector<int> a;
+		std::vector<double> b;
+		std::vector<long long> c;
+		intelligent_cast_read_columns(reader, a, b, c);
+		return a.size() + static_cast<unsigned long long>(c.back());
+	}, 5, "record");
+
+	return 0;
+}
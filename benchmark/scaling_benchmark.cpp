@@ -0,0 +1,141 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <atomic>
+#include <chrono>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "../IntelligentCast.h"
+
+// every thread formats and parses the same values, so that the threads share nothing but the code
+const size_t values_per_thread = 1 << 16;
+const int repeat = 8;
+
+// locale which has a decimal comma, set before the threads start to show that intelligent_cast does not depend on it
+const char* const comma_locales[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "German_Germany.1252", "fr_FR.UTF-8" };
+
+std::vector<double> make_values(unsigned int seed)
+{
+	std::vector<double> values(values_per_thread);
+	unsigned long long state = 88172645463325252ull + seed;
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		values[i] = static_cast<double>(state >> 11) / 9007199254740992.0 * 1e6;
+	}
+	return values;
+}
+
+// round trip of intelligent_cast, the texts are written into a buffer on the stack
+size_t round_trip_intelligent_cast(const std::vector<double>& values)
+{
+	size_t mismatches = 0;
+	char buf[32];
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		const intelligent_cast_to_result<char> text = intelligent_cast_to(buf, buf + sizeof(buf), values[i]);
+		mismatches += intelligent_cast<double>(static_cast<const char*>(buf), static_cast<const char*>(text.ptr)) != values[i];
+	}
+	return mismatches;
+}
+
+// round trip of snprintf and strtod, which consult the global locale
+size_t round_trip_crt(const std::vector<double>& values)
+{
+	size_t mismatches = 0;
+	char buf[32];
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		snprintf(buf, sizeof(buf), "%.17g", values[i]);
+		mismatches += std::strtod(buf, NULL) != values[i];
+	}
+	return mismatches;
+}
+
+// conversions per second of all threads, the threads start together and the slowest one decides the time
+double run(unsigned int threads, size_t (*round_trip)(const std::vector<double>&), size_t& mismatches)
+{
+	std::atomic<unsigned int> ready(0);
+	std::atomic<bool> go(false);
+	std::vector<size_t> results(threads);
+	std::vector<std::thread> workers;
+	for(unsigned int t = 0; t < threads; ++t)
+	{
+		workers.push_back(std::thread([&, t]()
+		{
+			const std::vector<double> values = make_values(t);
+			++ready;
+			while(!go.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+			for(int r = 0; r < repeat; ++r)
+			{
+				results[t] += round_trip(values);
+			}
+		}));
+	}
+	while(ready.load() != threads)
+	{
+		std::this_thread::yield();
+	}
+	const std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+	go.store(true, std::memory_order_release);
+	for(size_t t = 0; t < workers.size(); ++t)
+	{
+		workers[t].join();
+	}
+	const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	for(size_t t = 0; t < results.size(); ++t)
+	{
+		mismatches += results[t];
+	}
+	return static_cast<double>(values_per_thread) * repeat * threads / std::chrono::duration<double>(end - begin).count();
+}
+
+int main()
+{
+	const char* locale = NULL;
+	for(size_t i = 0; i < sizeof(comma_locales) / sizeof(comma_locales[0]) && !locale; ++i)
+	{
+		locale = std::setlocale(LC_ALL, comma_locales[i]);
+	}
+	char crt[32];
+	snprintf(crt, sizeof(crt), "%g", 1.5);
+	printf("locale %s: snprintf(1.5) = \"%s\", intelligent_cast(1.5) = \"%s\"\n\n",
+		locale ? locale : "\"C\" (no decimal comma locale installed)", crt, intelligent_cast<std::string>(1.5).c_str());
+
+	// 1, 2, 4, ... threads and all hardware threads
+	const unsigned int max_threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+	std::vector<unsigned int> thread_counts;
+	for(unsigned int threads = 1; threads < max_threads; threads *= 2)
+	{
+		thread_counts.push_back(threads);
+	}
+	thread_counts.push_back(max_threads);
+
+	printf("%-24s %8s %14s %9s %11s %11s\n", "method", "threads", "conversions/s", "speedup", "efficiency", "mismatches");
+	const char* const names[] = { "intelligent_cast", "snprintf + strtod" };
+	size_t (*const round_trips[])(const std::vector<double>&) = { round_trip_intelligent_cast, round_trip_crt };
+	for(size_t m = 0; m < 2; ++m)
+	{
+		double single = 0;
+		for(size_t i = 0; i < thread_counts.size(); ++i)
+		{
+			const unsigned int threads = thread_counts[i];
+			size_t mismatches = 0;
+			const double rate = run(threads, round_trips[m], mismatches);
+			if(threads == 1)
+			{
+				single = rate;
+			}
+			// speedup is near threads when the threads do not contend
+			printf("%-24s %8u %14.0f %8.2fx %10.0f%% %11u\n", names[m], threads, rate, rate / single, rate / single / threads * 100, static_cast<unsigned int>(mismatches));
+		}
+	}
+	return 0;
+}
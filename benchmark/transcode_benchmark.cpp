@@ -0,0 +1,80 @@
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../IntelligentCast.h"
+#include "benchmark_harness.h"
+
+// conversion used before the UTF-8 transcoder (scratch buffer, C runtime conversion, then copy)
+namespace legacy
+{
+	inline std::wstring to_wstring(const std::string& src)
+	{
+		std::vector<wchar_t> to(src.length() + 1);
+		const size_t size = mbstowcs(&to[0], src.c_str(), to.size());
+		return size == static_cast<size_t>(-1) ? std::wstring() : std::wstring(&to[0], size);
+	}
+	inline std::string to_mbstring(const std::wstring& src)
+	{
+		std::vector<char> to(src.length() * MB_CUR_MAX + 1);
+		const size_t size = wcstombs(&to[0], src.c_str(), to.size());
+		return size == static_cast<size_t>(-1) ? std::string() : std::string(&to[0], size);
+	}
+}
+
+// text is generated with a fixed seed, non_ascii of 100 characters are U+3042 (3 bytes in UTF-8)
+std::string make_text(size_t length, unsigned int non_ascii)
+{
+	std::string text;
+	unsigned long long state = 88172645463325252ull;
+	for(size_t i = 0; i < length; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		if(state % 100 < non_ascii)
+		{
+			text += "\xE3\x81\x82";
+		}
+		else
+		{
+			text += static_cast<char>('a' + state % 26);
+		}
+	}
+	return text;
+}
+
+void compare(const char* text_name, const std::string& text)
+{
+	char name[128];
+	const std::wstring wtext = intelligent_cast<std::wstring>(text);
+
+	snprintf(name, sizeof(name), "%s string -> wstring legacy", text_name);
+	run(name, wtext.size(), [&]() -> unsigned long long { return legacy::to_wstring(text).size(); }, 5000, "char");
+	snprintf(name, sizeof(name), "%s string -> wstring intelligent_cast", text_name);
+	run(name, wtext.size(), [&]() -> unsigned long long { return intelligent_cast<std::wstring>(text).size(); }, 5000, "char");
+	snprintf(name, sizeof(name), "%s wstring -> string legacy", text_name);
+	run(name, wtext.size(), [&]() -> unsigned long long { return legacy::to_mbstring(wtext).size(); }, 5000, "char");
+	snprintf(name, sizeof(name), "%s wstring -> string intelligent_cast", text_name);
+	run(name, wtext.size(), [&]() -> unsigned long long { return intelligent_cast<std::string>(wtext).size(); }, 5000, "char");
+}
+
+int main()
+{
+	// the legacy conversion reads UTF-8 only in a UTF-8 locale, which is named ".UTF-8" on Windows and "C.UTF-8" on glibc
+	const char* const utf8_locales[] = { ".UTF-8", "C.UTF-8", "en_US.UTF-8" };
+	const char* locale = NULL;
+	for(size_t i = 0; i < sizeof(utf8_locales) / sizeof(utf8_locales[0]) && !locale; ++i)
+	{
+		locale = setlocale(LC_ALL, utf8_locales[i]);
+	}
+	printf("locale %s\n", locale ? locale : "\"C\" (no UTF-8 locale installed, legacy conversion fails on non ascii text)");
+
+	compare("ascii", make_text(1 << 12, 0));
+	compare("10% non ascii", make_text(1 << 12, 10));
+	compare("japanese", make_text(1 << 12, 100));
+
+	return 0;
+}
@@ -30,5 +30,9 @@ int main()
 	std::string converted = str + 10 + " and " + 5.5;
 	// converted should be "results are 10 and 5.5"
 
+	// the numbers are not used further in this sample
+	(void)int_from_char;
+	(void)double_from_char;
+
 	return 0;
 }
\ No newline at end of file